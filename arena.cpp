@@ -0,0 +1,120 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 18:44:52
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 18:44:52
+*/
+
+#include "bigHeader.h"
+#include "arena.h"
+#include "csv_printer.h"
+#include "csv_reader.h"
+#include "heap_counter.h"
+
+#include <cstdio>
+#include <limits>
+#include <new>
+
+namespace{
+
+using ArenaRow = std::tuple<size_t,std::pmr::string,std::pmr::string>;
+
+void write_arena_csv(const char* path,size_t rows,MonotonicArena& arena){
+	ArenaResource resource(arena);
+	std::ofstream csvStream(path);
+	CSVPrinter<std::ofstream,size_t,std::string_view,std::string_view>
+		printer(csvStream,&resource,"RollNo","Name","Place");
+	printer.enableBuffering();
+
+	const std::string_view places[] = {"Kochi","Calicut","a place, with a comma"};
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(i,"a name long enough to leave the small string buffer",places[i % 3]);
+	}
+	printer.flush();
+}
+
+bool newHandlerCalled = false;
+
+void release_on_exhaustion(){
+	newHandlerCalled = true;
+	//nothing to free here, without a handler the next attempt throws
+	std::set_new_handler(nullptr);
+}
+
+/*
+ 	corner cases of the heap and arena contracts
+*/
+void check_allocation_contracts(){
+	MonotonicArena fresh;
+	ArenaResource resource(fresh);
+	if(!fresh.allocate(0) || !resource.allocate(0,1)){
+		throw std::runtime_error("a 0 byte arena allocation returned nullptr");
+	}
+
+	//the counting operator new consults the new_handler before throwing
+	volatile size_t huge = std::numeric_limits<size_t>::max() / 2;
+	std::set_new_handler(&release_on_exhaustion);
+	bool threw = false;
+	try{
+		void* volatile memory = ::operator new(huge);
+		::operator delete(memory);
+	}catch(const std::bad_alloc&){
+		threw = true;
+	}
+	std::set_new_handler(nullptr);
+	if(!threw || !newHandlerCalled){
+		throw std::runtime_error("operator new ignored the new_handler");
+	}
+}
+
+}
+
+void check_arena(){
+	check_allocation_contracts();
+	const size_t rows = 100000,batchRows = 1000;
+	MonotonicArena arena(1 << 20);
+	write_arena_csv("csv_arena.txt",rows,arena);
+	arena.reset();
+
+	/*
+	 	every batch of rows lives in the arena, the batch vector and the
+	 	strings of each row, and the whole batch is dropped with one reset
+	 */
+	ArenaResource resource(arena);
+	CSVReader<size_t,std::pmr::string,std::pmr::string> reader("csv_arena.txt","RollNo","Name","Place");
+	HeapCounters steadyState;
+	size_t batches = 0,read = 0,blocks = 0;
+	bool more = true;
+	while(more){
+		{
+			std::pmr::vector<ArenaRow> batch(&resource);
+			batch.reserve(batchRows);
+			ArenaRow row(std::allocator_arg,std::pmr::polymorphic_allocator<char>(&resource));
+			while(batch.size() < batchRows && (more = reader.readRow(row))){
+				batch.push_back(row);
+			}
+			for(const ArenaRow& parsed : batch){
+				if(std::get<0>(parsed) != read++ || std::get<2>(parsed).empty()){
+					throw std::runtime_error("arena row " + std::to_string(read - 1) + " is wrong");
+				}
+			}
+		}
+		arena.reset();
+		//the first batch sizes the arena and the reader, after that
+		//nothing may reach the global heap
+		if(++batches == 1){
+			steadyState = heapCounters();
+			blocks = arena.blocksAllocated();
+		}
+	}
+	const HeapCounters traffic = heapCounters() - steadyState;
+
+	std::cout << read << " rows in " << batches << " arena batches, " << arena.allocations()
+		<< " arena allocations in " << arena.blocksAllocated() << " blocks, global heap after the first batch: "
+		<< traffic.allocations << " allocations, " << traffic.deallocations << " frees" << std::endl;
+	std::remove("csv_arena.txt");
+	if(read != rows || traffic.allocations != 0 || arena.blocksAllocated() != blocks){
+		throw std::runtime_error("arena batches are not free of heap traffic");
+	}
+}
@@ -0,0 +1,191 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "bigHeader.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+/*
+ 	monotonic (bump pointer) arena
+
+ 	allocations are carved one after the other out of large blocks and are
+ 	never freed one by one
+ 	reset() rewinds to the first block in O(1) and keeps every block for
+ 	the next batch, release() or the destructor give the blocks back to
+ 	the heap
+ 	one arena belongs to one thread, there is no locking
+*/
+class MonotonicArena{
+	public:
+		explicit MonotonicArena(size_t blockSize = 64 * 1024)
+			:blockSize(blockSize){
+
+		}
+
+		~MonotonicArena(){
+			release();
+		}
+
+		MonotonicArena(const MonotonicArena&) = delete;
+		MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+		/**
+		 * @brief      bytes aligned to alignment, the next kept block or a
+		 *             new one is started when the current one is full
+		 *             never nullptr, not even for 0 bytes, as pmr requires
+		 */
+		void* allocate(size_t bytes,size_t alignment = alignof(std::max_align_t)){
+			uintptr_t aligned = (current + alignment - 1) & ~(uintptr_t(alignment) - 1);
+			if(!block || aligned + bytes > end){
+				grow(bytes + alignment);
+				aligned = (current + alignment - 1) & ~(uintptr_t(alignment) - 1);
+			}
+			current = aligned + bytes;
+			_bytesAllocated += bytes;
+			_allocations++;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		/**
+		 * @brief      everything allocated so far is gone, the blocks are
+		 *             kept and handed out again from the first one
+		 */
+		void reset(){
+			if(first){
+				use(first);
+			}
+			_bytesAllocated = 0;
+			_resets++;
+		}
+
+		/**
+		 * @brief      frees every block, everything allocated from the arena
+		 *             is gone
+		 */
+		void release(){
+			while(first){
+				Block* next = first->next;
+				::operator delete(first);
+				first = next;
+			}
+			block   = nullptr;
+			current = end = 0;
+			_blocks = 0;
+			_bytesAllocated = 0;
+		}
+
+		/**
+		 * @brief      bytes handed out since the last reset or release
+		 */
+		size_t bytesAllocated() const{
+			return _bytesAllocated;
+		}
+
+		/**
+		 * @brief      blocks held from the heap, the only heap allocations
+		 *             the arena makes, stays flat once batches repeat
+		 */
+		size_t blocksAllocated() const{
+			return _blocks;
+		}
+
+		/**
+		 * @brief      calls to allocate over the life of the arena
+		 */
+		size_t allocations() const{
+			return _allocations;
+		}
+
+		size_t resets() const{
+			return _resets;
+		}
+
+	private:
+		struct Block{
+			Block* next;
+			size_t size;
+		};
+
+		size_t blockSize;
+		Block* first      = nullptr;
+		Block* block      = nullptr;
+		uintptr_t current = 0;
+		uintptr_t end     = 0;
+		size_t _blocks    = 0;
+		size_t _bytesAllocated = 0;
+		size_t _allocations    = 0;
+		size_t _resets         = 0;
+
+		void use(Block* next){
+			block   = next;
+			current = reinterpret_cast<uintptr_t>(block + 1);
+			end     = reinterpret_cast<uintptr_t>(block) + block->size;
+		}
+
+		void grow(size_t atLeast){
+			//blocks kept by reset come first, too small ones are skipped
+			while(block && block->next){
+				use(block->next);
+				if(end - current >= atLeast){
+					return;
+				}
+			}
+			const size_t size = std::max(blockSize,atLeast + sizeof(Block));
+			Block* grown = static_cast<Block*>(::operator new(size));
+			grown->next = nullptr;
+			grown->size = size;
+			if(block){
+				block->next = grown;
+			}else{
+				first = grown;
+			}
+			use(grown);
+			_blocks++;
+		}
+};
+
+/*
+ 	std::pmr view of a MonotonicArena, for pmr containers and strings
+
+ 		MonotonicArena arena;
+ 		ArenaResource resource(arena);
+ 		std::pmr::vector<std::pmr::string> rows(&resource);
+
+ 	deallocate does nothing, the memory comes back with arena.reset()
+*/
+class ArenaResource : public std::pmr::memory_resource{
+	public:
+		explicit ArenaResource(MonotonicArena& arena)
+			:_arena(arena){
+
+		}
+
+		MonotonicArena& arena() const{
+			return _arena;
+		}
+
+	private:
+		MonotonicArena& _arena;
+
+		void* do_allocate(size_t bytes,size_t alignment) override{
+			return _arena.allocate(bytes,alignment);
+		}
+
+		void do_deallocate(void*,size_t,size_t) override{
+
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+			return this == &other;
+		}
+};
+
+/*
+ 	reads csv batches into arena backed pmr rows and checks with the heap
+ 	counters that steady state batches never touch the global heap
+*/
+void check_arena();
+
+#endif // ARENA_H
@@ -0,0 +1,250 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 15:40:27
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 15:40:27
+*/
+
+#include "bigHeader.h"
+#include "async_sink.h"
+#include "stopwatch.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace{
+
+//O_DIRECT wants the memory, the size and the file offset aligned
+const size_t directAlignment = 4096;
+
+size_t align_up(size_t size){
+	return (size + directAlignment - 1) / directAlignment * directAlignment;
+}
+
+}
+
+AsyncFileSink::AsyncFileSink(const std::string& path,AsyncSinkOptions options)
+	:options(options){
+	this->options.bufferSize = align_up(std::max<size_t>(options.bufferSize,1));
+	this->options.buffers    = std::max<size_t>(options.buffers,2);
+
+	const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+	if(options.direct){
+		fd = ::open(path.c_str(),flags | O_DIRECT,0644);
+		_direct = fd >= 0;
+	}
+	if(fd < 0){
+		fd = ::open(path.c_str(),flags,0644);
+	}
+	if(fd < 0){
+		throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+	}
+
+	buffers.resize(this->options.buffers);
+	for(Buffer& buffer : buffers){
+		buffer.data = static_cast<char*>(std::aligned_alloc(directAlignment,this->options.bufferSize));
+		if(!buffer.data){
+			for(Buffer& allocated : buffers){
+				std::free(allocated.data);
+			}
+			::close(fd);
+			throw std::bad_alloc();
+		}
+		freeBuffers.push_back(&buffer);
+	}
+	writer = std::thread(&AsyncFileSink::writerLoop,this);
+}
+
+AsyncFileSink::~AsyncFileSink(){
+	close();
+	for(Buffer& buffer : buffers){
+		std::free(buffer.data);
+	}
+}
+
+AsyncFileSink& AsyncFileSink::write(const char* data,std::streamsize n){
+	size_t remaining = static_cast<size_t>(n);
+	if(fd < 0){
+		_dropped += remaining;
+		return *this;
+	}
+	while(remaining > 0){
+		if(!current && !acquire()){
+			_dropped += remaining;
+			break;
+		}
+		const size_t chunk = std::min(remaining,options.bufferSize - current->size);
+		std::memcpy(current->data + current->size,data,chunk);
+		current->size += chunk;
+		data          += chunk;
+		remaining     -= chunk;
+		if(current->size == options.bufferSize){
+			submit(current);
+			current = nullptr;
+		}
+	}
+	return *this;
+}
+
+void AsyncFileSink::flush(){
+	if(fd < 0){
+		return;
+	}
+	if(current && current->size){
+		submit(current);
+		current = nullptr;
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	bufferReturned.wait(lock,[this]{ return inFlight == 0; });
+}
+
+void AsyncFileSink::close(){
+	if(fd < 0){
+		return;
+	}
+	flush();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	bufferSubmitted.notify_one();
+	writer.join();
+	::close(fd);
+	fd = -1;
+}
+
+bool AsyncFileSink::good() const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return error.empty();
+}
+
+/*
+ 	the only place a producer can wait, and only when the writer thread
+ 	still holds every buffer
+*/
+bool AsyncFileSink::acquire(){
+	std::unique_lock<std::mutex> lock(mutex);
+	if(options.pressure == BackPressure::Block){
+		bufferReturned.wait(lock,[this]{ return !freeBuffers.empty(); });
+	}else if(freeBuffers.empty()){
+		return false;
+	}
+	current = freeBuffers.front();
+	freeBuffers.pop_front();
+	current->size = 0;
+	return true;
+}
+
+void AsyncFileSink::submit(Buffer* buffer){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		fullBuffers.push_back(buffer);
+		inFlight++;
+	}
+	bufferSubmitted.notify_one();
+}
+
+void AsyncFileSink::writerLoop(){
+	std::unique_lock<std::mutex> lock(mutex);
+	for(;;){
+		bufferSubmitted.wait(lock,[this]{ return stopping || !fullBuffers.empty(); });
+		if(fullBuffers.empty()){
+			return;
+		}
+		Buffer* buffer = fullBuffers.front();
+		fullBuffers.pop_front();
+
+		lock.unlock();
+		writeBuffer(*buffer);
+		lock.lock();
+
+		buffer->size = 0;
+		freeBuffers.push_back(buffer);
+		inFlight--;
+		bufferReturned.notify_all();
+	}
+}
+
+void AsyncFileSink::writeBuffer(const Buffer& buffer){
+	//a partial buffer breaks the O_DIRECT alignment rules, the file
+	//falls back to buffered io from here on
+	if(_direct && buffer.size % directAlignment != 0){
+		::fcntl(fd,F_SETFL,::fcntl(fd,F_GETFL) & ~O_DIRECT);
+		_direct = false;
+	}
+	size_t written = 0;
+	while(written < buffer.size){
+		const ssize_t n = ::write(fd,buffer.data + written,buffer.size - written);
+		if(n < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			error = std::strerror(errno);
+			return;
+		}
+		written += static_cast<size_t>(n);
+	}
+}
+
+namespace{
+
+template<typename Stream>
+void export_rows(Stream& stream,size_t rows,double& producer){
+	CSVPrinter<Stream,
+		size_t,
+		Labeled<size_t>,
+		Labeled<size_t>,
+		Labeled<size_t>,
+		Labeled<size_t>> printer(stream,"RollNo","Name","Sem","Course","Place");
+	printer.enableBuffering();
+
+	Stopwatch watch;
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(i,label("Name",i),label("Sem",i),label("Course",i),label("Place",i));
+	}
+	printer.flush();
+	producer = watch.seconds();
+}
+
+}
+
+void bench_async_sink(size_t rows){
+	double producer = 0;
+	Stopwatch watch;
+	{
+		std::ofstream csvStream("csv_ofstream.txt");
+		export_rows(csvStream,rows,producer);
+		csvStream.flush();
+	}
+	const double ofstreamTotal = watch.seconds();
+	std::cout << "std::ofstream : producer " << producer << " s, total "
+		<< ofstreamTotal << " s" << std::endl;
+
+	watch.reset();
+	{
+		AsyncFileSink sink("csv_async.txt");
+		export_rows(sink,rows,producer);
+		sink.flush();
+	}
+	const double asyncTotal = watch.seconds();
+	std::cout << "AsyncFileSink : producer " << producer << " s, total "
+		<< asyncTotal << " s" << std::endl;
+
+	std::ifstream a("csv_ofstream.txt",std::ios::binary);
+	std::ifstream b("csv_async.txt",std::ios::binary);
+	const bool same = std::equal(
+		std::istreambuf_iterator<char>(a),std::istreambuf_iterator<char>(),
+		std::istreambuf_iterator<char>(b),std::istreambuf_iterator<char>());
+	std::cout << "outputs " << (same ? "match" : "DIFFER") << std::endl;
+
+	std::remove("csv_ofstream.txt");
+	std::remove("csv_async.txt");
+}
@@ -0,0 +1,134 @@
+#ifndef ASYNC_SINK_H
+#define ASYNC_SINK_H
+
+#include "bigHeader.h"
+#include "csv_printer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/*
+ 	what a producer does when every buffer is waiting for the disk
+*/
+enum class BackPressure{
+	Block, //wait for the writer thread to hand a buffer back
+	Drop   //discard the data and count it in dropped()
+};
+
+struct AsyncSinkOptions{
+	size_t bufferSize     = 1 << 20;
+	size_t buffers        = 8;
+	BackPressure pressure = BackPressure::Block;
+	bool direct           = false; //O_DIRECT when the file system allows it
+};
+
+/*
+ 	file sink with a ring of buffers and a background writer thread
+
+ 	the producer copies into the current buffer and hands full buffers to
+ 	the writer thread, which does the write syscalls, so the producer only
+ 	waits when all buffers are in flight (BackPressure::Block)
+
+ 	it can be used as the Stream of CSVPrinter (write and <<) and with
+ 	StreamPtr (close), one producer thread per sink
+ 	io_uring is not used, liburing is not part of the build
+*/
+class AsyncFileSink{
+	public:
+		explicit AsyncFileSink(const std::string& path,AsyncSinkOptions options = AsyncSinkOptions());
+		~AsyncFileSink();
+
+		AsyncFileSink(const AsyncFileSink&) = delete;
+		AsyncFileSink& operator=(const AsyncFileSink&) = delete;
+
+		/**
+		 * @brief      copies n bytes into the current buffer
+		 */
+		AsyncFileSink& write(const char* data,std::streamsize n);
+
+		/**
+		 * @brief      formats value the way RowBuffer::appendCell does
+		 */
+		template<typename T>
+		AsyncFileSink& operator<<(const T& value){
+			scratch.clear();
+			scratch.appendCell(value);
+			return write(scratch.data(),scratch.size());
+		}
+
+		/**
+		 * @brief      barrier, returns once everything written so far has
+		 *             been handed to the kernel
+		 */
+		void flush();
+
+		/**
+		 * @brief      flushes, stops the writer thread and closes the file
+		 */
+		void close();
+
+		bool is_open() const{
+			return fd >= 0;
+		}
+
+		/**
+		 * @brief      false once a write syscall has failed, like the
+		 *             failbit of an ofstream nothing is thrown
+		 */
+		bool good() const;
+
+		/**
+		 * @brief      bytes discarded under BackPressure::Drop
+		 */
+		size_t dropped() const{
+			return _dropped;
+		}
+
+		/**
+		 * @brief      true when the file was really opened with O_DIRECT
+		 */
+		bool direct() const{
+			return _direct;
+		}
+
+	private:
+		struct Buffer{
+			char* data  = nullptr;
+			size_t size = 0;
+		};
+
+		AsyncSinkOptions options;
+		int fd          = -1;
+		std::atomic<bool> _direct{false};
+		size_t _dropped = 0;
+
+		std::vector<Buffer> buffers;
+		Buffer* current = nullptr;
+		RowBuffer scratch;
+
+		mutable std::mutex mutex;
+		std::condition_variable bufferReturned;
+		std::condition_variable bufferSubmitted;
+		std::deque<Buffer*> freeBuffers;
+		std::deque<Buffer*> fullBuffers;
+		size_t inFlight = 0;
+		bool stopping   = false;
+		std::string error;
+		std::thread writer;
+
+		bool acquire();
+		void submit(Buffer* buffer);
+		void writerLoop();
+		void writeBuffer(const Buffer& buffer);
+};
+
+/*
+ 	csv export through std::ofstream against AsyncFileSink, reports the
+ 	time the producer is busy and the time until the data is written
+*/
+void bench_async_sink(size_t rows = 10000000);
+
+#endif // ASYNC_SINK_H
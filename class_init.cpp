@@ -7,6 +7,14 @@
 
 #include "bigHeader.h"
 #include "class_init.h"
+#include "pool.h"
+#include "stopwatch.h"
+#include "type_batched.h"
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <variant>
 
 /*
  1)	In class intitializer for non static data memebers
@@ -34,6 +42,10 @@ class JetPlane {
 		:manufacturer(manufacturer),model(model){
 
 		}
+
+		size_t engineCount() const{
+			return engines.size();
+		}
 		
 		static size_t getEngineCount(
 			const std::string& manufacturer,
@@ -277,4 +289,323 @@ void check_class_init(){
 
 	std::vector<int> core_points = extract_core_points({1,2,3,4,5,6});
 	return;
-}
\ No newline at end of file
+}
+
+namespace{
+
+/*
+ 	allocation heavy object graph, every plane and each of its two engines
+ 	is a separate heap object
+*/
+template<typename PlanePtr,typename EnginePtr>
+struct Fleet{
+	std::vector<PlanePtr> planes;
+	std::vector<EnginePtr> engines;
+};
+
+template<typename Fleet,typename MakePlane,typename MakeEngine>
+void bench_fleet(const char* name,size_t planes,MakePlane makePlane,MakeEngine makeEngine,
+	size_t (*heapCalls)()){
+	const size_t callsBefore = heapCalls();
+	Stopwatch watch;
+	Fleet fleet;
+	fleet.planes.reserve(planes);
+	fleet.engines.reserve(planes * 2);
+	for(size_t i = 0; i < planes; i++){
+		fleet.planes.push_back(makePlane());
+		fleet.engines.push_back(makeEngine());
+		fleet.engines.push_back(makeEngine());
+	}
+	const double build = watch.seconds();
+	const size_t calls = heapCalls() - callsBefore;
+
+	watch.reset();
+	size_t engines = 0;
+	for(int pass = 0; pass < 10; pass++){
+		for(const auto& plane : fleet.planes){
+			engines += plane->engineCount();
+		}
+	}
+	const double walk = watch.seconds();
+
+	watch.reset();
+	fleet.planes.clear();
+	fleet.engines.clear();
+	const double destroy = watch.seconds();
+
+	std::cout << name << ": build " << build << " s, walk " << walk << " s, destroy "
+		<< destroy << " s, heap allocations for the objects " << calls
+		<< " (" << engines / 10 << " engines)" << std::endl;
+}
+
+size_t newCalls = 0;
+
+size_t countedNewCalls(){
+	return newCalls;
+}
+
+size_t poolChunks(){
+	return FreeListPool<JetPlane>::local().chunksAllocated() +
+		FreeListPool<Engine>::local().chunksAllocated();
+}
+
+MonotonicArena* fleetArena = nullptr;
+
+size_t arenaBlocks(){
+	return fleetArena->blocksAllocated();
+}
+
+}
+
+void bench_pooled_planes(size_t planes){
+	bench_fleet<Fleet<std::unique_ptr<JetPlane>,std::unique_ptr<Engine>>>("new         ",planes,
+		[]{ newCalls++; return std::make_unique<JetPlane>("Airbus","A380-500"); },
+		[]{ newCalls++; return std::make_unique<Engine>(); },
+		&countedNewCalls);
+
+	bench_fleet<Fleet<pooled_ptr<JetPlane>,pooled_ptr<Engine>>>("make_pooled ",planes,
+		[]{ return make_pooled<JetPlane>("Airbus","A380-500"); },
+		[]{ return make_pooled<Engine>(); },
+		&poolChunks);
+
+	MonotonicArena arena(1 << 20);
+	fleetArena = &arena;
+	bench_fleet<Fleet<arena_ptr<JetPlane>,arena_ptr<Engine>>>("make_arena  ",planes,
+		[&]{ return make_arena<JetPlane>(arena,"Airbus","A380-500"); },
+		[&]{ return make_arena<Engine>(arena); },
+		&arenaBlocks);
+	fleetArena = nullptr;
+}
+
+namespace{
+
+/*
+ 	only pooled in check_pooled_planes, so the pools start out empty
+*/
+struct PooledProbe{
+	double payload[4];
+};
+
+}
+
+void check_pooled_planes(){
+	const size_t count = 1000;
+
+	//a thread fills its pool and exits, the slots must not be lost with it
+	std::thread([count]{
+		std::vector<pooled_ptr<PooledProbe>> probes;
+		for(size_t i = 0; i < count; i++){
+			probes.push_back(make_pooled<PooledProbe>());
+		}
+	}).join();
+
+	std::vector<pooled_ptr<PooledProbe>> probes;
+	for(size_t i = 0; i < count; i++){
+		probes.push_back(make_pooled<PooledProbe>());
+	}
+	if(FreeListPool<PooledProbe>::local().chunksAllocated() != 0){
+		throw std::runtime_error("the slots of an exited thread were not reused");
+	}
+
+	//freed on another thread, the slots go back through that thread's pool
+	std::thread([&probes]{
+		probes.clear();
+	}).join();
+	for(size_t i = 0; i < 2 * count; i++){
+		probes.push_back(make_pooled<PooledProbe>());
+	}
+	//the slots left over from the first thread's chunks and the count
+	//orphans come first, only the rest is carved from new chunks
+	const size_t slots    = FreeListPool<PooledProbe>::slotsPerChunk;
+	const size_t leftover = (count + slots - 1) / slots * slots - count;
+	const size_t carved   = 2 * count - leftover - count;
+	if(FreeListPool<PooledProbe>::local().chunksAllocated() != (carved + slots - 1) / slots){
+		throw std::runtime_error("slots freed on another thread were not reused");
+	}
+	std::cout << "pooled planes check passed" << std::endl;
+}
+
+namespace{
+
+/*
+ 	the plane hierarchy as plain value types, the same shape as Plane,
+ 	PropPlane and FloatPlane : Plane,Boat without the strings, and one
+ 	piece of behaviour, the fuel burnt per hour
+*/
+struct PlaneModel{
+	int engines;
+	double enginePower;
+};
+
+struct BoatModel{
+	double hullDrag;
+};
+
+struct SmallPlaneModel : PlaneModel{
+	double fuelPerHour() const{
+		return 0.2 * engines * enginePower;
+	}
+};
+
+struct PropPlaneModel : PlaneModel{
+	double propEfficiency;
+
+	double fuelPerHour() const{
+		return 0.25 * engines * enginePower / propEfficiency;
+	}
+};
+
+struct FloatPlaneModel : PlaneModel,BoatModel{
+	double fuelPerHour() const{
+		return 0.25 * engines * enginePower * (1.0 + hullDrag);
+	}
+};
+
+using PlaneBatches = TypeBatchedVector<SmallPlaneModel,PropPlaneModel,FloatPlaneModel>;
+using PlaneVariant = std::variant<SmallPlaneModel,PropPlaneModel,FloatPlaneModel>;
+
+/*
+ 	the same models behind a virtual base, one heap object each, the
+ 	way the planes are processed today
+*/
+class VirtualPlane{
+	public:
+		virtual ~VirtualPlane() = default;
+		virtual double fuelPerHour() const = 0;
+};
+
+template<typename Model>
+class VirtualPlaneOf : public VirtualPlane{
+	public:
+		explicit VirtualPlaneOf(const Model& model):model(model){
+
+		}
+
+		double fuelPerHour() const override{
+			return model.fuelPerHour();
+		}
+
+	private:
+		Model model;
+};
+
+/*
+ 	a mixed fleet in arrival order, every container gets the same planes
+*/
+struct MixedFleet{
+	std::vector<std::unique_ptr<VirtualPlane>> virtualPlanes;
+	std::vector<PlaneVariant> variants;
+	PlaneBatches batches;
+};
+
+template<typename Model>
+void add_plane(MixedFleet& fleet,const Model& model){
+	fleet.virtualPlanes.push_back(std::make_unique<VirtualPlaneOf<Model>>(model));
+	fleet.variants.push_back(model);
+	fleet.batches.push_back(model);
+}
+
+void build_fleet(MixedFleet& fleet,size_t planes){
+	std::mt19937 random(2358);
+	for(size_t i = 0; i < planes; i++){
+		const int engines = 1 + random() % 4;
+		const double power = 100.0 + random() % 900;
+		switch(random() % 3){
+			case 0:
+				add_plane(fleet,SmallPlaneModel{{engines,power}});
+				break;
+			case 1:
+				add_plane(fleet,PropPlaneModel{{engines,power},0.7 + (random() % 20) / 100.0});
+				break;
+			default:
+				add_plane(fleet,FloatPlaneModel{{engines,power},{(random() % 30) / 100.0}});
+				break;
+		}
+	}
+}
+
+double fuel_virtual(const MixedFleet& fleet){
+	double fuel = 0;
+	for(const auto& plane : fleet.virtualPlanes){
+		fuel += plane->fuelPerHour();
+	}
+	return fuel;
+}
+
+double fuel_variant(const MixedFleet& fleet){
+	double fuel = 0;
+	for(const PlaneVariant& plane : fleet.variants){
+		fuel += std::visit([](const auto& model){
+			return model.fuelPerHour();
+		},plane);
+	}
+	return fuel;
+}
+
+double fuel_batched(const MixedFleet& fleet){
+	double fuel = 0;
+	fleet.batches.for_each([&fuel](const auto& model){
+		fuel += model.fuelPerHour();
+	});
+	return fuel;
+}
+
+bool close(double a,double b){
+	return std::fabs(a - b) <= 1e-9 * std::max(std::fabs(a),std::fabs(b));
+}
+
+}
+
+void check_plane_batches(){
+	MixedFleet fleet;
+	build_fleet(fleet,3000);
+	const PlaneBatches& batches = fleet.batches;
+	if(batches.size() != 3000 || batches.batch<SmallPlaneModel>().empty() ||
+		batches.batch<PropPlaneModel>().empty() || batches.batch<FloatPlaneModel>().empty()){
+		throw std::runtime_error("plane batches lost planes");
+	}
+	if(!close(fuel_batched(fleet),fuel_virtual(fleet)) || !close(fuel_variant(fleet),fuel_virtual(fleet))){
+		throw std::runtime_error("plane batches disagree with the virtual calls");
+	}
+	size_t floats = 0;
+	batches.for_each_batch([&floats](const auto& vector){
+		using Model = typename std::decay_t<decltype(vector)>::value_type;
+		if(std::is_same<Model,FloatPlaneModel>::value){
+			floats += vector.size();
+		}
+	});
+	if(floats != batches.batch<FloatPlaneModel>().size()){
+		throw std::runtime_error("plane batches for_each_batch");
+	}
+	std::cout << "plane batches: " << batches.batch<SmallPlaneModel>().size() << " small, "
+		<< batches.batch<PropPlaneModel>().size() << " prop, " << floats << " float planes" << std::endl;
+}
+
+void bench_plane_dispatch(size_t planes,size_t rounds){
+	MixedFleet fleet;
+	build_fleet(fleet,planes);
+
+	auto run = [&](const char* name,double (*fuel)(const MixedFleet&),double& total){
+		//volatile so the compiler can not drop all but the last round
+		volatile double roundFuel = 0;
+		Stopwatch watch;
+		for(size_t r = 0; r < rounds; r++){
+			roundFuel = fuel(fleet);
+		}
+		total = roundFuel;
+		const double ns = watch.nanoseconds() / static_cast<double>(planes * rounds);
+		std::cout << "  " << name << ": " << ns << " ns per plane" << std::endl;
+		return ns;
+	};
+
+	std::cout << planes << " planes of 3 types in random order, " << rounds << " rounds" << std::endl;
+	double virtualFuel = 0,variantFuel = 0,batchedFuel = 0;
+	const double virtualTime = run("vector<unique_ptr<VirtualPlane>>",&fuel_virtual,virtualFuel);
+	const double variantTime = run("vector<variant> + visit         ",&fuel_variant,variantFuel);
+	const double batchedTime = run("TypeBatchedVector               ",&fuel_batched,batchedFuel);
+	if(!close(virtualFuel,batchedFuel) || !close(virtualFuel,variantFuel)){
+		throw std::runtime_error("plane dispatch bench: results differ");
+	}
+	std::cout << "  batched is " << virtualTime / batchedTime << "x the virtual calls, "
+		<< variantTime / batchedTime << "x the variant" << std::endl;
+}
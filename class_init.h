@@ -1,6 +1,32 @@
 #ifndef CLASS_INIT_H
 #define CLASS_INIT_H
 
+#include <cstddef>
+
 void check_class_init();
 
+/*
+ 	JetPlane / Engine object graph built with new, make_pooled and
+ 	make_arena, reports build, walk and destroy times and how many heap
+ 	allocations the objects themselves needed
+*/
+void bench_pooled_planes(size_t planes = 1000000);
+
+/*
+ 	slots of FreeListPool survive the thread that allocated or freed them
+*/
+void check_pooled_planes();
+
+/*
+ 	the plane models in a TypeBatchedVector against virtual calls and a
+ 	variant, all three must burn the same fuel
+*/
+void check_plane_batches();
+
+/*
+ 	fuel of a mixed fleet through vector<unique_ptr<Base>> virtual calls,
+ 	vector<variant> with visit and a TypeBatchedVector
+*/
+void bench_plane_dispatch(size_t planes = 1000000,size_t rounds = 20);
+
 #endif // CLASS_INIT_H
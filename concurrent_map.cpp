@@ -0,0 +1,85 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 20:21:40
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 20:21:40
+*/
+
+#include "bigHeader.h"
+#include "concurrent_map.h"
+#include "stopwatch.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+namespace{
+
+const size_t benchKeys = 100000;
+
+/*
+ 	threads run opsPerThread operations each, readPercent of them finds
+ 	and the rest insert_or_assign, all on keys of a prefilled map
+*/
+template<typename Map>
+double run_mix(Map& map,const std::vector<std::string>& keys,size_t threads,
+	size_t opsPerThread,unsigned readPercent){
+	std::atomic<size_t> ready{0};
+	std::atomic<size_t> found{0};
+	std::vector<std::thread> workers;
+	Stopwatch watch;
+	for(size_t t = 0; t < threads; t++){
+		workers.emplace_back([&,t]{
+			std::mt19937_64 random(t + 1);
+			ready++;
+			while(ready.load() < threads){
+				std::this_thread::yield();
+			}
+			size_t hits = 0;
+			for(size_t i = 0; i < opsPerThread; i++){
+				const uint64_t r = random();
+				const std::string& key = keys[r % keys.size()];
+				if((r >> 32) % 100 < readPercent){
+					hits += map.find(key).has_value();
+				}else{
+					map.insert_or_assign(key,i);
+				}
+			}
+			found += hits;
+		});
+	}
+	for(std::thread& worker : workers){
+		worker.join();
+	}
+	return threads * opsPerThread / watch.seconds() / 1e6;
+}
+
+template<size_t Shards>
+void bench_shards(const char* name,const std::vector<std::string>& keys,
+	size_t maxThreads,size_t opsPerThread,unsigned readPercent){
+	ConcurrentStrKeyMap<size_t,FlatBackend,Shards> map;
+	for(size_t i = 0; i < keys.size(); i++){
+		map.insert_or_assign(keys[i],i);
+	}
+	std::cout << "  " << name << ":";
+	for(size_t threads = 1; threads <= maxThreads; threads *= 2){
+		std::cout << " " << threads << "t " << run_mix(map,keys,threads,opsPerThread,readPercent);
+	}
+	std::cout << " Mops/s" << std::endl;
+}
+
+}
+
+void bench_concurrent_map(size_t maxThreads,size_t opsPerThread){
+	std::vector<std::string> keys;
+	keys.reserve(benchKeys);
+	for(size_t i = 0; i < benchKeys; i++){
+		keys.push_back("key" + std::to_string(i));
+	}
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	for(unsigned readPercent : {90u,50u}){
+		std::cout << readPercent << "/" << 100 - readPercent << " read/write" << std::endl;
+		bench_shards<1>("1 shard  ",keys,maxThreads,opsPerThread,readPercent);
+		bench_shards<64>("64 shards",keys,maxThreads,opsPerThread,readPercent);
+	}
+}
@@ -0,0 +1,186 @@
+#ifndef CONCURRENT_MAP_H
+#define CONCURRENT_MAP_H
+
+#include "bigHeader.h"
+#include "template_alias.h"
+
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+
+/*
+ 	thread safe StrKeyMap split into Shards independent maps
+
+ 	a key always lives in the shard picked by its hash, every shard has
+ 	its own reader/writer lock so readers never block each other and
+ 	writers only block the users of one shard
+ 	Backend is any StrKeyMap backend with string keys (Tree, Flat, Sorted)
+
+ 		ConcurrentStrKeyMap<int> map;
+ 		map.insert_or_assign("first",1);
+ 		std::optional<int> value = map.find("first");
+*/
+template<typename T,typename Backend = FlatBackend,size_t Shards = 64>
+class ConcurrentStrKeyMap{
+	static_assert(Shards && (Shards & (Shards - 1)) == 0,"Shards must be a power of two");
+
+	public:
+		/*
+		 	read access to one value, holds the shard's shared lock for as
+		 	long as it lives, writers of that shard wait meanwhile
+		 	do not hold a guard while taking another one or calling
+		 	for_each, the shard locks would be taken out of order
+		*/
+		class ConstGuard{
+			public:
+				ConstGuard(std::shared_lock<std::shared_mutex> lock,const T* value)
+					:lock(std::move(lock)),value(value){
+
+				}
+
+				explicit operator bool() const{
+					return value != nullptr;
+				}
+
+				const T& operator*() const{
+					return *value;
+				}
+
+				const T* operator->() const{
+					return value;
+				}
+
+			private:
+				std::shared_lock<std::shared_mutex> lock;
+				const T* value;
+		};
+
+		/**
+		 * @brief      inserts key or overwrites its value
+		 *
+		 * @return     true when key was new
+		 */
+		template<typename Value>
+		bool insert_or_assign(std::string_view key,Value&& value){
+			Shard& shard = shardOf(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			//find first, std::map only builds its std::string key on insert
+			const auto found = shard.map.find(key);
+			if(found != shard.map.end()){
+				found->second = std::forward<Value>(value);
+				return false;
+			}
+			shard.map.emplace(key,std::forward<Value>(value));
+			return true;
+		}
+
+		/**
+		 * @brief      copy of the value of key, taken under the shard lock
+		 */
+		std::optional<T> find(std::string_view key) const{
+			const Shard& shard = shardOf(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			const auto found = shard.map.find(key);
+			if(found == shard.map.end()){
+				return std::nullopt;
+			}
+			return found->second;
+		}
+
+		/**
+		 * @brief      the value of key without a copy, empty guard when
+		 *             the key is missing
+		 */
+		ConstGuard find_guard(std::string_view key) const{
+			const Shard& shard = shardOf(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			const auto found = shard.map.find(key);
+			const T* value = found == shard.map.end() ? nullptr : &found->second;
+			return ConstGuard(std::move(lock),value);
+		}
+
+		bool erase(std::string_view key){
+			Shard& shard = shardOf(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			return shard.map.erase(key) != 0;
+		}
+
+		size_t size() const{
+			size_t total = 0;
+			for(const Shard& shard : shards){
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				total += shard.map.size();
+			}
+			return total;
+		}
+
+		/**
+		 * @brief      calls f(key, value) on a consistent snapshot, every
+		 *             shard is read locked while the entries are copied and
+		 *             f runs without any lock held, so f may use the map
+		 */
+		template<typename Func>
+		void for_each(Func f) const{
+			std::vector<std::pair<std::string,T>> snapshot;
+			{
+				std::vector<std::shared_lock<std::shared_mutex>> locks;
+				locks.reserve(Shards);
+				//always in shard order, writers only ever hold one lock
+				for(const Shard& shard : shards){
+					locks.emplace_back(shard.mutex);
+				}
+				size_t total = 0;
+				for(const Shard& shard : shards){
+					total += shard.map.size();
+				}
+				snapshot.reserve(total);
+				for(const Shard& shard : shards){
+					for(const auto& entry : shard.map){
+						snapshot.emplace_back(std::string(std::string_view(entry.first)),entry.second);
+					}
+				}
+			}
+			for(const auto& entry : snapshot){
+				f(std::string_view(entry.first),entry.second);
+			}
+		}
+
+	private:
+		//one cache line per lock so shards do not false share
+		struct alignas(64) Shard{
+			mutable std::shared_mutex mutex;
+			StrKeyMap<T,Backend> map;
+		};
+
+		std::array<Shard,Shards> shards;
+
+		/**
+		 * @brief      the top bits of the mixed hash pick the shard, the
+		 *             low bits are left to the hash map inside the shard
+		 */
+		static size_t shardIndex(std::string_view key){
+			if constexpr(Shards == 1){
+				return 0;
+			}else{
+				const uint64_t hash = std::hash<std::string_view>()(key) * 0x9E3779B97F4A7C15ULL;
+				return static_cast<size_t>(hash >> (64 - __builtin_ctzll(Shards)));
+			}
+		}
+
+		Shard& shardOf(std::string_view key){
+			return shards[shardIndex(key)];
+		}
+
+		const Shard& shardOf(std::string_view key) const{
+			return shards[shardIndex(key)];
+		}
+};
+
+/*
+ 	million operations per second for 1 to maxThreads threads at 90/10
+ 	and 50/50 read/write, 64 shards against a single locked map
+*/
+void bench_concurrent_map(size_t maxThreads = 32,size_t opsPerThread = 200000);
+
+#endif // CONCURRENT_MAP_H
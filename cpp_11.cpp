@@ -1,5 +1,10 @@
 #include "bigHeader.h"
 #include "cpp_11.h"
+#include "fibonacci.h"
+#include "inplace_function.h"
+#include "soa_vector.h"
+#include "stopwatch.h"
+#include <random>
 
 int func(double){
 	return 10;
@@ -24,16 +29,14 @@ template<class Func>
 
 /*
 	find out febenocci series using lambda expression
+	a recursive std::function pays a type erased call on every step and
+	takes exponential time, the lambda forwards to the engine in
+	fibonacci.h instead, F(n) for n < 1 stays -1 and from F(93) on, which
+	does not fit in a long long, std::overflow_error is thrown
 */	
 
-std::function<int(int)> fibonacci = [&](int n)-> int{
-	if(n < 1){
-		return -1;
-	}else if(n == 1 || n == 2){
-		return 1;
-	}else {
-		return fibonacci(n-1) + fibonacci (n-2);
-	}
+std::function<long long(int)> lambda_fibonacci = [](int n)-> long long{
+	return n < 1 ? -1 : fibonacci_as<long long>(n);
 };	
 
 void check_lambda(){
@@ -82,6 +85,10 @@ void check_lambda(){
 		auto e = fleet; // type of e is JetPlane*
 		auto &f = fleet; //type of f is JetPlane(&)[10] - a reference
 
+		//the same fleet a column per field, scanning a is one contiguous array
+		soa_vector<int,std::string> fleetColumns(10);
+		[[maybe_unused]] auto [fleetA,fleetName] = fleetColumns[0]; // int& and std::string& into the columns
+
 		auto g = func; //type of g is int(*)double
 		auto &h = func; // type of h is int(&)(double)
 
@@ -155,22 +162,21 @@ void check_lambda(){
 	*/
 
 	{
-		class LambdaStore{
-		private:	
-			std::function<bool(double)> _stored_lambda;
-		public:
-			std::function<int(int)> get_abs() const{
-				return [](int i){ return abs(i);};
-			}
-		
-			void set_lambda(const std::function<bool(double)>& lambda){
-				_stored_lambda = lambda;
-			}	
-		};
-	
 		LambdaStore ls;
 		ls.set_lambda([](double d){ return d > 0.0;});
 
+		/*
+			written with auto the same lambda also takes a DoubleBatch,
+			stored with set_batch_lambda test_batch checks four values per call
+		*/
+		const double values[] = {-2.0,-1.0,0.0,1.0,2.0};
+		ls.set_batch_lambda([](auto d){ return d > 0.0;});
+		std::cout <<"positive mask= " <<ls.test_batch(values,5)[0]<<std::endl;
+
+		//a generic lambda that only works on one value stays scalar
+		ls.set_lambda([](auto d){ if(d > 0.0) return true; return false;});
+		std::cout <<"positive mask= " <<ls.test_batch(values,5)[0]<<std::endl;
+
 		auto abs_lambda = ls.get_abs();
 		std::cout <<"abs_lambda= " <<abs_lambda(-10)<<std::endl;;
 	}
@@ -223,4 +229,47 @@ void check_lambda(){
 		[capture_block](parameter_list) mutable exception_spec -> return_type {body}
 	*/
 		return ;
-}
\ No newline at end of file
+}
+
+void bench_lambda_store(size_t count,size_t repeat){
+	std::vector<double> values(count);
+	std::mt19937_64 random(42);
+	std::uniform_real_distribution<double> distribution(-1.0,1.0);
+	for(double& value : values){
+		value = distribution(random);
+	}
+	std::vector<uint64_t> perValue((count + 63) / 64);
+	std::vector<uint64_t> scalar(perValue.size());
+	std::vector<uint64_t> batch(perValue.size());
+
+	LambdaStore ls;
+	ls.set_lambda([](double d){ return d > 0.0;});
+	Stopwatch watch;
+	for(size_t r = 0; r < repeat; r++){
+		std::fill(perValue.begin(),perValue.end(),0);
+		for(size_t i = 0; i < count; i++){
+			perValue[i / 64] |= static_cast<uint64_t>(ls.test(values[i])) << i % 64;
+		}
+	}
+	const double perValueTime = watch.seconds();
+
+	watch.reset();
+	for(size_t r = 0; r < repeat; r++){
+		ls.test_batch(values.data(),count,scalar.data());
+	}
+	const double scalarTime = watch.seconds();
+
+	ls.set_batch_lambda([](auto d){ return d > 0.0;});
+	watch.reset();
+	for(size_t r = 0; r < repeat; r++){
+		ls.test_batch(values.data(),count,batch.data());
+	}
+	const double batchTime = watch.seconds();
+
+	const double total = static_cast<double>(count) * repeat;
+	std::cout << "stored call per value : " << perValueTime / total * 1e9 << " ns/value" << std::endl;
+	std::cout << "scalar batch          : " << scalarTime / total * 1e9 << " ns/value" << std::endl;
+	std::cout << "vectorized batch      : " << batchTime / total * 1e9 << " ns/value, "
+		<< perValueTime / batchTime << "x" << std::endl;
+	std::cout << "masks " << (perValue == scalar && scalar == batch ? "match" : "DIFFER") << std::endl;
+}
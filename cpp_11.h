@@ -1,7 +1,136 @@
 #ifndef CPP_11_H
 #define CPP_11_H
 
+#include "bigHeader.h"
+#include "inplace_function.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+/*
+ 	four doubles as one GCC vector, one ymm register with -mavx
+ 	comparisons on it give a lane mask of -1 / 0 per lane
+*/
+using DoubleBatch     = double __attribute__((vector_size(4 * sizeof(double))));
+using DoubleBatchMask = decltype(DoubleBatch{} > DoubleBatch{});
+
+constexpr size_t doubleBatchLanes = sizeof(DoubleBatch) / sizeof(double);
+
+/**
+ * @brief      one bit per lane, bit i set when lane i is true
+ */
+inline uint64_t batchMaskBits(const DoubleBatchMask& mask){
+#ifdef __AVX__
+	return static_cast<uint64_t>(_mm256_movemask_pd(reinterpret_cast<__m256d>(mask)));
+#else
+	uint64_t bits = 0;
+	for(size_t lane = 0; lane < doubleBatchLanes; lane++){
+		bits |= static_cast<uint64_t>(mask[lane] & 1) << lane;
+	}
+	return bits;
+#endif
+}
+
+/**
+ * @brief      applies predicate to count values, bit i % 64 of
+ *             mask[i / 64] is the answer for values[i], (count + 63) / 64
+ *             words are written and unused high bits are zero
+ *             with Batched the predicate gets four values per call and
+ *             the tail one at a time, otherwise one value per call
+ */
+template<bool Batched,typename Predicate>
+void testBatch(Predicate& predicate,const double* values,size_t count,uint64_t* mask){
+	for(size_t base = 0; base < count; base += 64){
+		const size_t n = std::min<size_t>(64,count - base);
+		const double* word = values + base;
+		uint64_t bits = 0;
+		size_t i = 0;
+		if constexpr(Batched){
+			for(; i + doubleBatchLanes <= n; i += doubleBatchLanes){
+				DoubleBatch batch;
+				std::memcpy(&batch,word + i,sizeof(batch));
+				bits |= batchMaskBits(predicate(batch)) << i;
+			}
+		}
+		for(; i < n; i++){
+			bits |= static_cast<uint64_t>(static_cast<bool>(predicate(word[i]))) << i;
+		}
+		mask[base / 64] = bits;
+	}
+}
+
+/*
+	use of inplace_function to store lambda expressions
+	the stored predicate can be applied to one value or to a whole array,
+	the batch version is generated for the concrete lambda type so there
+	is no indirect call per value
+	set_lambda always tests one value per call, set_batch_lambda is the
+	opt in for predicates that also take a whole DoubleBatch
+*/
+class LambdaStore{
+	private:
+		inplace_function<bool(double)> _stored_lambda;
+		inplace_function<void(const double*,size_t,uint64_t*)> _stored_batch;
+	public:
+		inplace_function<int(int)> get_abs() const{
+			return [](int i){ return abs(i);};
+		}
+
+		template<typename Predicate>
+		void set_lambda(Predicate lambda){
+			store<false>(lambda);
+		}
+
+		/**
+		 * @brief      stores a predicate that also answers a DoubleBatch with
+		 *             a lane mask, like [](auto d){ return d > 0.0; },
+		 *             test_batch then checks four values per call
+		 */
+		template<typename Predicate>
+		void set_batch_lambda(Predicate lambda){
+			static_assert(std::is_same<std::invoke_result_t<Predicate&,DoubleBatch>,DoubleBatchMask>::value,
+				"a batch predicate has to answer a DoubleBatch with a DoubleBatchMask");
+			store<true>(lambda);
+		}
+
+		bool test(double value) const{
+			return _stored_lambda(value);
+		}
+
+		/**
+		 * @brief      packed result for count values, see testBatch
+		 */
+		void test_batch(const double* values,size_t count,uint64_t* mask) const{
+			_stored_batch(values,count,mask);
+		}
+
+		std::vector<uint64_t> test_batch(const double* values,size_t count) const{
+			std::vector<uint64_t> mask((count + 63) / 64);
+			test_batch(values,count,mask.data());
+			return mask;
+		}
+
+	private:
+		template<bool Batched,typename Predicate>
+		void store(Predicate lambda){
+			_stored_lambda = lambda;
+			_stored_batch  = [lambda](const double* values,size_t count,uint64_t* mask) mutable{
+				testBatch<Batched>(lambda,values,count,mask);
+			};
+		}
+};
 
 void check_lambda();
 
+/*
+ 	d > 0.0 over count values, one stored call per value against the
+ 	scalar and the vectorized batch
+*/
+void bench_lambda_store(size_t count = 1 << 20,size_t repeat = 100);
+
 #endif // CPP_11_H
@@ -0,0 +1,292 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 14:05:12
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 14:05:12
+*/
+
+#include "bigHeader.h"
+#include "csv_columnar.h"
+#include "csv_reader.h"
+#include "stopwatch.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+namespace{
+
+uint64_t align_up(uint64_t offset){
+	return (offset + columnarAlignment - 1) / columnarAlignment * columnarAlignment;
+}
+
+void pad_to(std::ofstream& out,uint64_t& position,uint64_t offset){
+	static const char zeros[columnarAlignment] = {};
+	while(position < offset){
+		const uint64_t n = std::min<uint64_t>(offset - position,sizeof(zeros));
+		out.write(zeros,n);
+		position += n;
+	}
+}
+
+}
+
+void writeColumnar(const std::string& path,uint64_t rows,
+	std::vector<ColumnEntry> entries,
+	const std::vector<std::array<ColumnRegion,3>>& regions){
+	//every array starts on its own page so it can be mapped alone
+	uint64_t offset = align_up(sizeof(ColumnarHeader) + entries.size() * sizeof(ColumnEntry));
+	for(size_t c = 0; c < entries.size(); c++){
+		uint64_t* placement[3][2] = {
+			{&entries[c].valuesOffset,&entries[c].valuesSize},
+			{&entries[c].offsetsOffset,&entries[c].offsetsSize},
+			{&entries[c].heapOffset,&entries[c].heapSize}};
+		for(size_t r = 0; r < 3; r++){
+			*placement[r][0] = offset;
+			*placement[r][1] = regions[c][r].size;
+			offset = align_up(offset + regions[c][r].size);
+		}
+	}
+
+	ColumnarHeader header = {};
+	std::memcpy(header.magic,columnarMagic,sizeof(header.magic));
+	header.version = columnarVersion;
+	header.columns = entries.size();
+	header.rows    = rows;
+
+	std::ofstream out(path,std::ios::binary);
+	if(!out){
+		throw std::runtime_error("cannot write " + path);
+	}
+	out.write(reinterpret_cast<const char*>(&header),sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()),entries.size() * sizeof(ColumnEntry));
+	uint64_t position = sizeof(header) + entries.size() * sizeof(ColumnEntry);
+	for(size_t c = 0; c < entries.size(); c++){
+		const uint64_t offsets[3] = {entries[c].valuesOffset,entries[c].offsetsOffset,entries[c].heapOffset};
+		for(size_t r = 0; r < 3; r++){
+			pad_to(out,position,offsets[r]);
+			out.write(regions[c][r].data,regions[c][r].size);
+			position += regions[c][r].size;
+		}
+	}
+	if(!out){
+		throw std::runtime_error("failed writing " + path);
+	}
+}
+
+namespace{
+
+bool inside(uint64_t offset,uint64_t size,uint64_t fileSize){
+	return offset <= fileSize && size <= fileSize - offset;
+}
+
+/*
+ 	a column entry has to describe arrays of the declared shape that lie
+ 	inside the file, a stale or truncated sidecar throws here instead of
+ 	faulting when the column is read
+*/
+void validate(const ColumnEntry& entry,uint64_t rows,uint64_t fileSize,const std::string& path){
+	if(!std::memchr(entry.name,'\0',sizeof(entry.name))){
+		throw std::runtime_error(path + " has a column name without a terminator");
+	}
+	const std::string name(entry.name);
+	if(entry.kind > ColumnKind::Labeled || entry.valueKind > ColumnKind::Labeled){
+		throw std::runtime_error("column " + name + " has an unknown kind in " + path);
+	}
+	if(!inside(entry.valuesOffset,entry.valuesSize,fileSize) ||
+		!inside(entry.offsetsOffset,entry.offsetsSize,fileSize) ||
+		!inside(entry.heapOffset,entry.heapSize,fileSize)){
+		throw std::runtime_error("column " + name + " lies past the end of " + path);
+	}
+	const bool hasValues  = entry.kind != ColumnKind::String;
+	const bool hasStrings = entry.kind == ColumnKind::String || entry.kind == ColumnKind::Labeled;
+	//rows are bounded by the file size first so the products do not wrap
+	if((hasValues && (entry.width == 0 || rows > fileSize / entry.width ||
+			entry.valuesSize != rows * entry.width)) ||
+		(!hasValues && entry.valuesSize != 0) ||
+		(hasStrings && (rows >= fileSize / sizeof(uint64_t) ||
+			entry.offsetsSize != (rows + 1) * sizeof(uint64_t))) ||
+		(!hasStrings && (entry.offsetsSize != 0 || entry.heapSize != 0))){
+		throw std::runtime_error("column " + name + " does not hold " + std::to_string(rows) + " rows in " + path);
+	}
+}
+
+}
+
+ColumnarFile::ColumnarFile(const std::string& path):path(path){
+	std::ifstream in(path,std::ios::binary | std::ios::ate);
+	const uint64_t fileSize = in ? static_cast<uint64_t>(in.tellg()) : 0;
+	in.seekg(0);
+	ColumnarHeader header = {};
+	in.read(reinterpret_cast<char*>(&header),sizeof(header));
+	if(!in || std::memcmp(header.magic,columnarMagic,sizeof(header.magic)) != 0){
+		throw std::runtime_error(path + " is not a columnar sidecar");
+	}
+	if(header.version != columnarVersion){
+		throw std::runtime_error(path + " has sidecar version " + std::to_string(header.version));
+	}
+	if(header.columns > (fileSize - sizeof(header)) / sizeof(ColumnEntry)){
+		throw std::runtime_error(path + " has a truncated column table");
+	}
+	_rows = header.rows;
+	entries.resize(header.columns);
+	in.read(reinterpret_cast<char*>(entries.data()),entries.size() * sizeof(ColumnEntry));
+	if(!in){
+		throw std::runtime_error(path + " has a truncated column table");
+	}
+	for(const ColumnEntry& entry : entries){
+		validate(entry,_rows,fileSize,path);
+	}
+}
+
+const ColumnEntry& ColumnarFile::find(const std::string& name) const{
+	for(const ColumnEntry& entry : entries){
+		if(name == entry.name){
+			return entry;
+		}
+	}
+	throw std::runtime_error("no column " + name + " in " + path);
+}
+
+namespace{
+
+using Row = std::tuple<size_t,Labeled<size_t>,FixedPoint<2>,std::string_view>;
+
+/*
+ 	text and sidecar from the same printer
+*/
+void write_with_sidecar(const char* text,const char* sidecar,size_t rows){
+	std::ofstream csvStream(text);
+	CSVPrinter<std::ofstream,size_t,Labeled<size_t>,FixedPoint<2>,std::string_view>
+		printer(csvStream,"RollNo","Name","Fee","Place");
+	ColumnarWriter<size_t,Labeled<size_t>,FixedPoint<2>,std::string_view>
+		columns("RollNo","Name","Fee","Place");
+	printer.enableBuffering();
+	printer.attachSidecar(columns);
+
+	const std::string_view places[] = {"Kochi","Calicut","Trivandrum"};
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(i,label("Name",i),FixedPoint<2>{static_cast<long long>(i * 125)},places[i % 3]);
+	}
+	printer.flush();
+	columns.write(sidecar);
+}
+
+/*
+ 	any string like value goes into any text column, both in the text and
+ 	in the sidecar
+*/
+void check_mixed_strings(){
+	std::ostringstream text;
+	CSVPrinter<std::ostringstream,const char*,std::string,std::string_view>
+		printer(text,"Code","Model","Place");
+	ColumnarWriter<const char*,std::string,std::string_view> columns("Code","Model","Place");
+	printer.attachSidecar(columns);
+
+	const std::string code = "AI";
+	const std::string_view model = "A380";
+	printer.outputLine(code,model,"Kochi");
+	printer.outputLine("EK",std::string("B777"),code);
+	printer.outputLine(model.data(),"A350",std::string_view("Calicut"));
+	columns.write("csv_mixed.col");
+
+	const ColumnarFile file("csv_mixed.col");
+	const auto codes  = file.column<std::string_view>("Code");
+	const auto models = file.column<std::string_view>("Model");
+	const auto places = file.column<std::string_view>("Place");
+	std::remove("csv_mixed.col");
+	if(text.str() != "AI,A380,Kochi\nEK,B777,AI\nA380,A350,Calicut\n" || file.rows() != 3 ||
+		codes[0] != "AI" || models[1] != "B777" || places[1] != "AI" || codes[2] != "A380" || places[2] != "Calicut"){
+		throw std::runtime_error("mixed string like values differ between text and sidecar");
+	}
+}
+
+}
+
+void check_csv_columnar(){
+	check_mixed_strings();
+
+	write_with_sidecar("csv_sidecar.txt","csv_sidecar.col",20);
+
+	ColumnarFile file("csv_sidecar.col");
+	const auto roll   = file.column<size_t>("RollNo");
+	const auto names  = file.column<Labeled<size_t>>("Name");
+	const auto fees   = file.column<FixedPoint<2>>("Fee");
+	const auto places = file.column<std::string_view>("Place");
+
+	CSVReader<size_t,Labeled<size_t>,FixedPoint<2>,std::string_view>
+		reader("csv_sidecar.txt","RollNo","Name","Fee","Place");
+	size_t i = 0;
+	reader.forEachRow([&](const Row& row){
+		const bool same = roll[i] == std::get<0>(row) &&
+			names[i].label == std::get<1>(row).label && names[i].value == std::get<1>(row).value &&
+			fees[i].scaled == std::get<2>(row).scaled &&
+			places[i] == std::get<3>(row);
+		if(!same){
+			throw std::runtime_error("sidecar row " + std::to_string(i) + " differs from the text");
+		}
+		i++;
+	});
+	if(i != file.rows() || roll.size() != file.rows() || places.size() != file.rows()){
+		throw std::runtime_error("sidecar row count differs from the text");
+	}
+
+	//a projection maps the same pages as the single columns
+	const auto [projectedRoll,projectedPlaces] = file.project<size_t,std::string_view>("RollNo","Place");
+	for(size_t row = 0; row < file.rows(); row++){
+		if(projectedRoll[row] != roll[row] || projectedPlaces[row] != places[row]){
+			throw std::runtime_error("sidecar projection row " + std::to_string(row) + " differs");
+		}
+	}
+	//a truncated sidecar throws instead of faulting on the first read
+	std::ifstream whole("csv_sidecar.col",std::ios::binary);
+	const std::string bytes((std::istreambuf_iterator<char>(whole)),std::istreambuf_iterator<char>());
+	std::ofstream("csv_truncated.col",std::ios::binary).write(bytes.data(),bytes.size() - columnarAlignment);
+	bool truncatedThrew = false;
+	try{
+		ColumnarFile truncated("csv_truncated.col");
+		truncated.column<std::string_view>("Place");
+	}catch(const std::runtime_error&){
+		truncatedThrew = true;
+	}
+	std::remove("csv_truncated.col");
+	if(!truncatedThrew){
+		throw std::runtime_error("a truncated sidecar was accepted");
+	}
+
+	std::cout << "sidecar matches the text: " << file.rows() << " rows, "
+		<< file.columns().size() << " columns" << std::endl;
+	std::remove("csv_sidecar.txt");
+	std::remove("csv_sidecar.col");
+}
+
+void bench_csv_columnar(size_t rows){
+	write_with_sidecar("csv_columnar.txt","csv_columnar.col",rows);
+
+	Stopwatch watch;
+	long long textSum = 0;
+	CSVReader<size_t,Labeled<size_t>,FixedPoint<2>,std::string_view>
+		reader("csv_columnar.txt","RollNo","Name","Fee","Place");
+	reader.forEachRow([&](const Row& row){
+		textSum += std::get<2>(row).scaled;
+	});
+	const double text = watch.seconds();
+
+	watch.reset();
+	long long columnSum = 0;
+	const ColumnarFile file("csv_columnar.col");
+	for(const FixedPoint<2>& fee : file.column<FixedPoint<2>>("Fee")){
+		columnSum += fee.scaled;
+	}
+	const double column = watch.seconds();
+
+	std::cout << "sum of Fee re-parsing text : " << text << " s" << std::endl;
+	std::cout << "sum of Fee from the sidecar: " << column << " s" << std::endl;
+	std::cout << "speed up " << text / column << "x, sums "
+		<< (textSum == columnSum ? "match" : "DIFFER") << std::endl;
+
+	std::remove("csv_columnar.txt");
+	std::remove("csv_columnar.col");
+}
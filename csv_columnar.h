@@ -0,0 +1,467 @@
+#ifndef CSV_COLUMNAR_H
+#define CSV_COLUMNAR_H
+
+#include "bigHeader.h"
+#include "csv_printer.h"
+#include "mapped_file.h"
+#include <cstdint>
+
+/*
+ 	columnar binary sidecar for CSVPrinter data
+
+ 	layout:
+ 		ColumnarHeader
+ 		ColumnEntry for every column (name, type and where its arrays are)
+ 		page aligned arrays, per column up to three of them
+ 			values   contiguous fixed width values
+ 			offsets  rows + 1 uint64 offsets into the heap
+ 			heap     string bytes
+
+ 	numbers and FixedPoint only have values, strings have offsets and
+ 	heap, Labeled keeps its numbers in values and its labels as strings
+*/
+enum class ColumnKind : uint32_t{
+	Signed,
+	Unsigned,
+	Float,
+	Bool,
+	String,
+	Fixed,
+	Labeled
+};
+
+struct ColumnarHeader{
+	char magic[8];
+	uint64_t version;
+	uint64_t columns;
+	uint64_t rows;
+};
+
+struct ColumnEntry{
+	char name[64];
+	ColumnKind kind;
+	uint32_t width;
+	uint32_t decimals;
+	ColumnKind valueKind;
+	uint64_t valuesOffset;
+	uint64_t valuesSize;
+	uint64_t offsetsOffset;
+	uint64_t offsetsSize;
+	uint64_t heapOffset;
+	uint64_t heapSize;
+};
+
+static const char columnarMagic[8] = {'C','S','V','C','O','L','\0','\0'};
+static const uint64_t columnarVersion = 1;
+static const uint64_t columnarAlignment = 4096;
+
+/*
+ 	column type description derived from the CSVPrinter column types
+*/
+template<typename T,typename = void>
+struct ColumnTraits;
+
+template<typename T>
+struct ColumnTraits<T,std::enable_if_t<std::is_arithmetic<T>::value>>{
+	static constexpr ColumnKind kind = std::is_same<T,bool>::value ? ColumnKind::Bool
+		: std::is_floating_point<T>::value ? ColumnKind::Float
+		: std::is_signed<T>::value ? ColumnKind::Signed : ColumnKind::Unsigned;
+	static constexpr uint32_t width        = sizeof(T);
+	static constexpr uint32_t decimals     = 0;
+	static constexpr ColumnKind valueKind  = kind;
+};
+
+template<typename T>
+struct ColumnTraits<T,std::enable_if_t<IsCSVString<T>::value>>{
+	static constexpr ColumnKind kind       = ColumnKind::String;
+	static constexpr uint32_t width        = 0;
+	static constexpr uint32_t decimals     = 0;
+	static constexpr ColumnKind valueKind  = kind;
+};
+
+template<unsigned Decimals>
+struct ColumnTraits<FixedPoint<Decimals>>{
+	static constexpr ColumnKind kind       = ColumnKind::Fixed;
+	static constexpr uint32_t width        = sizeof(long long);
+	static constexpr uint32_t decimals     = Decimals;
+	static constexpr ColumnKind valueKind  = kind;
+};
+
+template<typename Number>
+struct ColumnTraits<Labeled<Number>>{
+	static constexpr ColumnKind kind       = ColumnKind::Labeled;
+	static constexpr uint32_t width        = sizeof(Number);
+	static constexpr uint32_t decimals     = 0;
+	static constexpr ColumnKind valueKind  = ColumnTraits<Number>::kind;
+};
+
+/*
+ 	one byte range of the file, filled in by the column builders
+*/
+struct ColumnRegion{
+	const char* data;
+	size_t size;
+};
+
+/*
+ 	in memory column while rows are appended, one per Columns... type
+*/
+template<typename T,typename = void>
+class ColumnBuilder{
+	public:
+		void append(const T& value){
+			values.push_back(value);
+		}
+
+		std::array<ColumnRegion,3> regions() const{
+			return {{asRegion(values),{nullptr,0},{nullptr,0}}};
+		}
+
+	private:
+		std::vector<T> values;
+
+		template<typename Value>
+		static ColumnRegion asRegion(const std::vector<Value>& v){
+			return {reinterpret_cast<const char*>(v.data()),v.size() * sizeof(Value)};
+		}
+};
+
+/*
+ 	std::vector<bool> is not contiguous, bools are kept as bytes
+*/
+template<>
+class ColumnBuilder<bool>{
+	public:
+		void append(bool value){
+			values.push_back(value);
+		}
+
+		std::array<ColumnRegion,3> regions() const{
+			return {{{reinterpret_cast<const char*>(values.data()),values.size()},
+				{nullptr,0},{nullptr,0}}};
+		}
+
+	private:
+		std::vector<uint8_t> values;
+};
+
+class StringColumnBuilder{
+	public:
+		void append(std::string_view value){
+			heap.append(value.data(),value.size());
+			offsets.push_back(heap.size());
+		}
+
+		ColumnRegion offsetRegion() const{
+			return {reinterpret_cast<const char*>(offsets.data()),offsets.size() * sizeof(uint64_t)};
+		}
+
+		ColumnRegion heapRegion() const{
+			return {heap.data(),heap.size()};
+		}
+
+	private:
+		std::vector<uint64_t> offsets{0};
+		std::string heap;
+};
+
+template<typename T>
+class ColumnBuilder<T,std::enable_if_t<IsCSVString<T>::value>>{
+	public:
+		void append(std::string_view value){
+			strings.append(value);
+		}
+
+		std::array<ColumnRegion,3> regions() const{
+			return {{{nullptr,0},strings.offsetRegion(),strings.heapRegion()}};
+		}
+
+	private:
+		StringColumnBuilder strings;
+};
+
+template<unsigned Decimals>
+class ColumnBuilder<FixedPoint<Decimals>>{
+	public:
+		void append(const FixedPoint<Decimals>& value){
+			values.push_back(value.scaled);
+		}
+
+		std::array<ColumnRegion,3> regions() const{
+			return {{{reinterpret_cast<const char*>(values.data()),values.size() * sizeof(long long)},
+				{nullptr,0},{nullptr,0}}};
+		}
+
+	private:
+		std::vector<long long> values;
+};
+
+template<typename Number>
+class ColumnBuilder<Labeled<Number>>{
+	public:
+		void append(const Labeled<Number>& value){
+			values.push_back(value.value);
+			labels.append(value.label);
+		}
+
+		std::array<ColumnRegion,3> regions() const{
+			return {{{reinterpret_cast<const char*>(values.data()),values.size() * sizeof(Number)},
+				labels.offsetRegion(),labels.heapRegion()}};
+		}
+
+	private:
+		std::vector<Number> values;
+		StringColumnBuilder labels;
+};
+
+/**
+ * @brief      writes the collected columns, shared by every ColumnarWriter
+ */
+void writeColumnar(const std::string& path,uint64_t rows,
+	std::vector<ColumnEntry> entries,
+	const std::vector<std::array<ColumnRegion,3>>& regions);
+
+/*
+ 	collects rows column by column and writes the sidecar file, it can be
+ 	attached to a CSVPrinter or used on its own instead of the text output
+*/
+template<typename... Columns>
+class ColumnarWriter{
+	static_assert((IsCSVColumn<Columns>::value && ...),
+		"Columns must be numbers, strings, FixedPoint or Labeled");
+
+	public:
+		template<typename... Headers>
+		ColumnarWriter(const Headers&... headers)
+			:headers({std::string(headers)...}){
+			static_assert(sizeof...(Headers) == sizeof...(Columns),
+            "Number of headers must match number of columns");
+			for(const std::string& header : this->headers){
+				if(header.size() >= sizeof(ColumnEntry::name)){
+					throw std::length_error("column name too long for the sidecar: " + header);
+				}
+			}
+		}
+
+		template<typename... Values>
+		void append(const Values&... values){
+			static_assert(sizeof...(Values) == sizeof...(Columns),
+			"Number of values must match number of columns");
+			static_assert((CSVCellMatches<Columns,Values>::value && ...),
+			"Value types must match the column types");
+			appendColumns(std::index_sequence_for<Columns...>(),values...);
+			rows++;
+		}
+
+		/**
+		 * @brief      writes the sidecar file
+		 *
+		 * @param[in]  path  The path
+		 */
+		void write(const std::string& path) const{
+			std::vector<ColumnEntry> entries;
+			std::vector<std::array<ColumnRegion,3>> regions;
+			describe(std::index_sequence_for<Columns...>(),entries,regions);
+			writeColumnar(path,rows,entries,regions);
+		}
+
+		uint64_t size() const{
+			return rows;
+		}
+
+	private:
+		std::array<std::string,sizeof...(Columns)> headers;
+		std::tuple<ColumnBuilder<Columns>...> builders;
+		uint64_t rows = 0;
+
+		template<size_t... Is,typename... Values>
+		void appendColumns(std::index_sequence<Is...>,const Values&... values){
+			(std::get<Is>(builders).append(values),...);
+		}
+
+		template<size_t... Is>
+		void describe(std::index_sequence<Is...>,std::vector<ColumnEntry>& entries,
+			std::vector<std::array<ColumnRegion,3>>& regions) const{
+			(describeColumn<Is,Columns>(entries,regions),...);
+		}
+
+		template<size_t I,typename Column>
+		void describeColumn(std::vector<ColumnEntry>& entries,
+			std::vector<std::array<ColumnRegion,3>>& regions) const{
+			ColumnEntry entry = {};
+			std::memcpy(entry.name,headers[I].data(),headers[I].size());
+			entry.kind      = ColumnTraits<Column>::kind;
+			entry.width     = ColumnTraits<Column>::width;
+			entry.decimals  = ColumnTraits<Column>::decimals;
+			entry.valueKind = ColumnTraits<Column>::valueKind;
+			entries.push_back(entry);
+			regions.push_back(std::get<I>(builders).regions());
+		}
+};
+
+/*
+ 	views over one mapped column, only the pages of that column are mapped
+*/
+template<typename T>
+class NumericColumn{
+	public:
+		NumericColumn(const std::string& path,const ColumnEntry& entry)
+			:values(path,entry.valuesOffset,entry.valuesSize){
+
+		}
+
+		const T* data() const{
+			return reinterpret_cast<const T*>(values.data());
+		}
+
+		size_t size() const{
+			return values.size() / sizeof(T);
+		}
+
+		const T& operator[](size_t i) const{
+			return data()[i];
+		}
+
+		const T* begin() const{
+			return data();
+		}
+
+		const T* end() const{
+			return data() + size();
+		}
+
+	private:
+		MappedFile values;
+};
+
+class StringColumn{
+	public:
+		StringColumn(const std::string& path,const ColumnEntry& entry)
+			:offsets(path,entry.offsetsOffset,entry.offsetsSize),
+			heap(path,entry.heapOffset,entry.heapSize){
+			//the offsets grow from 0 to the heap size, the last one is enough
+			//to catch a heap that does not belong to them
+			const uint64_t* bounds = reinterpret_cast<const uint64_t*>(offsets.data());
+			const size_t count = offsets.size() / sizeof(uint64_t);
+			if(count == 0 || bounds[0] != 0 || bounds[count - 1] != heap.size()){
+				throw std::runtime_error(std::string("string offsets of column ") + entry.name
+					+ " do not match its heap in " + path);
+			}
+		}
+
+		size_t size() const{
+			return offsets.size() / sizeof(uint64_t) - 1;
+		}
+
+		std::string_view operator[](size_t i) const{
+			const uint64_t* bounds = reinterpret_cast<const uint64_t*>(offsets.data());
+			return std::string_view(heap.data() + bounds[i],bounds[i + 1] - bounds[i]);
+		}
+
+	private:
+		MappedFile offsets;
+		MappedFile heap;
+};
+
+template<typename Number>
+class LabeledColumn{
+	public:
+		LabeledColumn(const std::string& path,const ColumnEntry& entry)
+			:values(path,entry),labels(path,entry){
+
+		}
+
+		size_t size() const{
+			return values.size();
+		}
+
+		Labeled<Number> operator[](size_t i) const{
+			return Labeled<Number>{labels[i],values[i]};
+		}
+
+		const NumericColumn<Number>& numbers() const{
+			return values;
+		}
+
+	private:
+		NumericColumn<Number> values;
+		StringColumn labels;
+};
+
+template<typename T,typename = void>
+struct ColumnViewFor{
+	using type = NumericColumn<T>;
+};
+
+template<typename T>
+struct ColumnViewFor<T,std::enable_if_t<IsCSVString<T>::value>>{
+	using type = StringColumn;
+};
+
+template<typename Number>
+struct ColumnViewFor<Labeled<Number>>{
+	using type = LabeledColumn<Number>;
+};
+
+/*
+ 	reads the header and column table of a sidecar file, each column is
+ 	mapped on its own when asked for
+*/
+class ColumnarFile{
+	public:
+		explicit ColumnarFile(const std::string& path);
+
+		uint64_t rows() const{
+			return _rows;
+		}
+
+		const std::vector<ColumnEntry>& columns() const{
+			return entries;
+		}
+
+		/**
+		 * @brief      maps the named column, T has to be the type the
+		 *             column was written with
+		 */
+		template<typename T>
+		typename ColumnViewFor<T>::type column(const std::string& name) const{
+			const ColumnEntry& entry = find(name);
+			if(entry.kind != ColumnTraits<T>::kind || entry.width != ColumnTraits<T>::width ||
+				entry.decimals != ColumnTraits<T>::decimals || entry.valueKind != ColumnTraits<T>::valueKind){
+				throw std::runtime_error("column " + name + " has a different type in " + path);
+			}
+			return typename ColumnViewFor<T>::type(path,entry);
+		}
+
+		/**
+		 * @brief      maps only the named columns, one view per name typed
+		 *             by the matching T, no value is copied
+		 *
+		 *             auto [roll,places] = file.project<size_t,std::string_view>("RollNo","Place");
+		 */
+		template<typename... Ts,typename... Names>
+		std::tuple<typename ColumnViewFor<Ts>::type...> project(const Names&... names) const{
+			static_assert(sizeof...(Ts) == sizeof...(Names),"ColumnarFile::project takes one name per type");
+			return std::tuple<typename ColumnViewFor<Ts>::type...>(column<Ts>(names)...);
+		}
+
+	private:
+		std::string path;
+		uint64_t _rows = 0;
+		std::vector<ColumnEntry> entries;
+
+		const ColumnEntry& find(const std::string& name) const;
+};
+
+/*
+ 	writes text and sidecar through one printer and checks single
+ 	mapped columns against the parsed text
+*/
+void check_csv_columnar();
+
+/*
+ 	scans one column of the sidecar against re-parsing the text file
+*/
+void bench_csv_columnar(size_t rows = 10000000);
+
+#endif // CSV_COLUMNAR_H
@@ -0,0 +1,195 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 09:12:40
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 09:12:40
+*/
+
+#include "bigHeader.h"
+#include "csv_printer.h"
+#include "stopwatch.h"
+
+#include <cstdio>
+#include <iterator>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace{
+
+using StringPrinter = CSVPrinter<std::ofstream,
+	std::string,
+	std::string,
+	std::string,
+	std::string,
+	std::string>;
+
+using TypedPrinter = CSVPrinter<std::ofstream,
+	size_t,
+	Labeled<size_t>,
+	Labeled<size_t>,
+	Labeled<size_t>,
+	Labeled<size_t>>;
+
+using NumericPrinter = CSVPrinter<std::ofstream,
+	size_t,
+	double,
+	float>;
+
+/*
+ 	same rows as check_var_temp, the strings are built by the caller
+*/
+double export_rows(const char* path,size_t rows,bool buffered){
+	std::ofstream csvStream(path);
+	StringPrinter printer(csvStream,"RollNo","Name","Sem","Course","Place");
+	if(buffered){
+		printer.enableBuffering();
+	}
+
+	Stopwatch watch;
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(
+			std::to_string(i),
+			"Name"+std::to_string(i),
+			"Sem"+std::to_string(i),
+			"Course"+std::to_string(i),
+			"Place"+std::to_string(i)
+		);
+	}
+	printer.flush();
+	csvStream.close();
+	return watch.seconds();
+}
+
+/*
+ 	typed columns, the numbers are formatted into the row buffer
+*/
+double export_typed_rows(const char* path,size_t rows){
+	std::ofstream csvStream(path);
+	TypedPrinter printer(csvStream,"RollNo","Name","Sem","Course","Place");
+	printer.enableBuffering();
+
+	Stopwatch watch;
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(
+			i,
+			label("Name",i),
+			label("Sem",i),
+			label("Course",i),
+			label("Place",i)
+		);
+	}
+	printer.flush();
+	csvStream.close();
+	return watch.seconds();
+}
+
+/*
+ 	floating point columns, both paths have to print the same digits
+*/
+double export_numeric_rows(const char* path,size_t rows,bool buffered){
+	std::ofstream csvStream(path);
+	NumericPrinter printer(csvStream,"RollNo","Ratio","Weight");
+	if(buffered){
+		printer.enableBuffering();
+	}
+
+	Stopwatch watch;
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(i,i / 3.0,static_cast<float>(i) / 7.0f);
+	}
+	printer.flush();
+	csvStream.close();
+	return watch.seconds();
+}
+
+double export_parallel_rows(const char* path,size_t rows){
+	std::ofstream csvStream(path);
+	TypedPrinter printer(csvStream,"RollNo","Name","Sem","Course","Place");
+	printer.enableBuffering();
+
+	Stopwatch watch;
+	printer.outputHeaders();
+	printer.outputLinesParallel(rows,[](size_t i){
+		return std::make_tuple(i,label("Name",i),label("Sem",i),label("Course",i),label("Place",i));
+	});
+	printer.flush();
+	csvStream.close();
+	return watch.seconds();
+}
+
+bool same_file(const char* lhs,const char* rhs){
+	std::ifstream a(lhs,std::ios::binary);
+	std::ifstream b(rhs,std::ios::binary);
+	return std::equal(
+		std::istreambuf_iterator<char>(a),std::istreambuf_iterator<char>(),
+		std::istreambuf_iterator<char>(b),std::istreambuf_iterator<char>());
+}
+
+void report(const char* name,size_t rows,double seconds){
+	std::cout << name << ": " << seconds << " s, "
+		<< rows / seconds / 1e6 << " Mrows/s" << std::endl;
+}
+
+}
+
+void bench_csv_printer(size_t rows){
+	const double streamed = export_rows("csv_stream.txt",rows,false);
+	const double buffered = export_rows("csv_buffered.txt",rows,true);
+	const double typed    = export_typed_rows("csv_typed.txt",rows);
+
+	report("stream << per cell",rows,streamed);
+	report("buffered rows     ",rows,buffered);
+	report("typed columns     ",rows,typed);
+	std::cout << "speed up " << streamed / buffered << "x buffered, "
+		<< streamed / typed << "x typed, outputs "
+		<< (same_file("csv_stream.txt","csv_buffered.txt") &&
+			same_file("csv_stream.txt","csv_typed.txt") ? "match" : "DIFFER")
+		<< std::endl;
+
+	const double numericStreamed = export_numeric_rows("csv_numeric_stream.txt",rows,false);
+	const double numericBuffered = export_numeric_rows("csv_numeric_buffered.txt",rows,true);
+	report("numbers stream    ",rows,numericStreamed);
+	report("numbers buffered  ",rows,numericBuffered);
+	std::cout << "speed up " << numericStreamed / numericBuffered << "x, outputs "
+		<< (same_file("csv_numeric_stream.txt","csv_numeric_buffered.txt") ? "match" : "DIFFER")
+		<< std::endl;
+
+	std::remove("csv_stream.txt");
+	std::remove("csv_buffered.txt");
+	std::remove("csv_typed.txt");
+	std::remove("csv_numeric_stream.txt");
+	std::remove("csv_numeric_buffered.txt");
+}
+
+void bench_csv_parallel(size_t rows){
+	const double serial = export_typed_rows("csv_serial.txt",rows);
+	report("serial buffered",rows,serial);
+
+#ifdef _OPENMP
+	const int maxThreads = omp_get_max_threads();
+#else
+	const int maxThreads = 1;
+#endif
+	for(int threads = 1; threads <= maxThreads; threads *= 2){
+#ifdef _OPENMP
+		omp_set_num_threads(threads);
+#endif
+		const double parallel = export_parallel_rows("csv_parallel.txt",rows);
+		std::cout << threads << " threads: ";
+		report("parallel",rows,parallel);
+		std::cout << "speed up " << serial / parallel << "x, output "
+			<< (same_file("csv_serial.txt","csv_parallel.txt") ? "matches" : "DIFFERS")
+			<< std::endl;
+	}
+#ifdef _OPENMP
+	omp_set_num_threads(maxThreads);
+#endif
+
+	std::remove("csv_serial.txt");
+	std::remove("csv_parallel.txt");
+}
@@ -0,0 +1,787 @@
+#ifndef CSV_PRINTER_H
+#define CSV_PRINTER_H
+
+#include "bigHeader.h"
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*
+ 	contiguous byte buffer used by the buffered mode of CSVPrinter
+ 	whole rows are formatted in here and handed to the sink
+ 	as one large write instead of one stream call per cell
+*/
+class RowBuffer{
+	public:
+		explicit RowBuffer(size_t capacity = 0){
+			reserve(capacity);
+		}
+
+		/**
+		 * @brief      grows the buffer so it can hold capacity bytes
+		 *             without reallocating
+		 */
+		void reserve(size_t capacity){
+			if(capacity <= _capacity){
+				return;
+			}
+			std::unique_ptr<char[]> grown(new char[capacity]);
+			if(_size){
+				std::memcpy(grown.get(),_data.get(),_size);
+			}
+			_data = std::move(grown);
+			_capacity = capacity;
+		}
+
+		template<bool Checked = true>
+		void append(char c){
+			if constexpr(Checked){
+				ensure(1);
+			}
+			_data[_size++] = c;
+		}
+
+		void append(const char* s,size_t n){
+			ensure(n);
+			std::memcpy(_data.get() + _size,s,n);
+			_size += n;
+		}
+
+		void append(std::string_view s){
+			append(s.data(),s.size());
+		}
+
+		/**
+		 * @brief      formats a number with std::to_chars, no locale and
+		 *             no intermediate string
+		 */
+		template<bool Checked = true,typename Number>
+		void appendNumber(Number value){
+			if constexpr(Checked){
+				ensure(maxChars<Number>());
+			}
+			auto result = std::to_chars(_data.get() + _size,_data.get() + _capacity,value);
+			_size = result.ptr - _data.get();
+		}
+
+		/**
+		 * @brief      formats one cell, types with a formatTo member write
+		 *             themselves, numbers go through to_chars and
+		 *             everything else is appended as a string_view
+		 *             with Checked false the caller has already made room
+		 *             for the cell, see reserveRow
+		 */
+		template<bool Checked = true,typename Value>
+		void appendCell(const Value& value){
+			if constexpr(HasFormatTo<Value>::value){
+				value.formatTo(*this);
+			}else if constexpr(std::is_same<Value,bool>::value){
+				append<Checked>(value ? '1' : '0');
+			}else if constexpr(std::is_same<Value,char>::value){
+				append<Checked>(value);
+			}else if constexpr(std::is_arithmetic<Value>::value){
+				appendNumber<Checked>(value);
+			}else{
+				append(std::string_view(value));
+			}
+		}
+
+		/**
+		 * @brief      one capacity check for a whole row of at most n bytes
+		 */
+		void reserveRow(size_t n){
+			ensure(n);
+		}
+
+		/**
+		 * @brief      widest text to_chars can produce for a Number
+		 */
+		template<typename Number>
+		static constexpr size_t maxChars(){
+			//sign, digits and for floating point the shortest round trip form
+			return std::is_floating_point<Number>::value ? 32
+				: std::numeric_limits<Number>::digits10 + 3;
+		}
+
+		/**
+		 * @brief      overwrites the last byte, used to turn the trailing
+		 *             word delimeter of a row into the line delimeter
+		 */
+		void replaceLast(char c){
+			_data[_size - 1] = c;
+		}
+
+		/**
+		 * @brief      hands everything buffered to the sink in one write
+		 */
+		template<typename Stream>
+		void flushTo(Stream& stream){
+			if(_size){
+				stream.write(_data.get(),_size);
+				_size = 0;
+			}
+		}
+
+		void clear(){
+			_size = 0;
+		}
+
+		const char* data() const{
+			return _data.get();
+		}
+
+		size_t size() const{
+			return _size;
+		}
+
+		size_t capacity() const{
+			return _capacity;
+		}
+
+	private:
+		template<typename T,typename = void>
+		struct HasFormatTo : std::false_type{};
+
+		template<typename T>
+		struct HasFormatTo<T,std::void_t<decltype(
+			std::declval<const T&>().formatTo(std::declval<RowBuffer&>()))>>
+			: std::true_type{};
+
+		std::unique_ptr<char[]> _data;
+		size_t _size     = 0;
+		size_t _capacity = 0;
+
+		void ensure(size_t n){
+			if(_size + n > _capacity){
+				reserve(std::max(_capacity * 2,_size + n));
+			}
+		}
+};
+
+/*
+ 	fixed point column, FixedPoint<2>{12345} is written as 123.45
+ 	without going through floating point
+*/
+template<unsigned Decimals>
+struct FixedPoint{
+	long long scaled;
+
+	static constexpr unsigned long long scale(){
+		unsigned long long value = 1;
+		for(unsigned i = 0; i < Decimals; i++){
+			value *= 10;
+		}
+		return value;
+	}
+
+	/**
+	 * @brief      writes the value to out, returns one past the last char
+	 *             out needs room for 22 chars
+	 */
+	char* format(char* out) const{
+		unsigned long long magnitude = scaled < 0
+			? 0ULL - static_cast<unsigned long long>(scaled)
+			: static_cast<unsigned long long>(scaled);
+		if(scaled < 0){
+			*out++ = '-';
+		}
+		out = std::to_chars(out,out + 20,magnitude / scale()).ptr;
+		if constexpr(Decimals > 0){
+			*out++ = '.';
+			unsigned long long fraction = magnitude % scale();
+			for(unsigned i = Decimals; i > 0; i--){
+				out[i - 1] = static_cast<char>('0' + fraction % 10);
+				fraction /= 10;
+			}
+			out += Decimals;
+		}
+		return out;
+	}
+
+	void formatTo(RowBuffer& buffer) const{
+		char digits[22 + Decimals];
+		buffer.append(digits,format(digits) - digits);
+	}
+};
+
+template<unsigned Decimals>
+std::ostream& operator<<(std::ostream& os,const FixedPoint<Decimals>& value){
+	char digits[22 + Decimals];
+	return os.write(digits,value.format(digits) - digits);
+}
+
+/*
+ 	a number with a constant prefix, Labeled<int>{"Name",5} is written
+ 	as Name5 so callers dont have to build "Name"+std::to_string(i)
+*/
+template<typename Number>
+struct Labeled{
+	using NumberType = Number;
+
+	std::string_view label;
+	Number value;
+
+	void formatTo(RowBuffer& buffer) const{
+		buffer.append(label);
+		buffer.appendNumber(value);
+	}
+};
+
+template<typename T>
+struct IsLabeled : std::false_type{};
+
+template<typename Number>
+struct IsLabeled<Labeled<Number>> : std::true_type{};
+
+template<typename Number>
+Labeled<Number> label(std::string_view prefix,Number value){
+	return Labeled<Number>{prefix,value};
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os,const Labeled<Number>& value){
+	return os << value.label << value.value;
+}
+
+/*
+ 	compile time checks on the column types of CSVPrinter
+*/
+template<typename T>
+struct IsCSVString : std::integral_constant<bool,
+	std::is_same<T,std::string>::value ||
+	std::is_same<T,std::pmr::string>::value ||
+	std::is_same<T,std::string_view>::value ||
+	std::is_same<T,const char*>::value ||
+	std::is_same<T,char*>::value>{};
+
+template<typename T>
+struct IsCSVCell : std::false_type{};
+
+template<unsigned Decimals>
+struct IsCSVCell<FixedPoint<Decimals>> : std::true_type{};
+
+template<typename Number>
+struct IsCSVCell<Labeled<Number>> : std::is_arithmetic<Number>{};
+
+template<typename T>
+struct IsCSVColumn : std::integral_constant<bool,
+	std::is_arithmetic<T>::value || IsCSVString<T>::value || IsCSVCell<T>::value>{};
+
+/**
+ * @brief      a value can go into a column when it has exactly the column
+ *             type, strings may be passed as any of the string like types
+ *             since none of them needs a conversion to be written
+ */
+template<typename Column,typename Value>
+struct CSVCellMatches : std::integral_constant<bool,
+	std::is_same<Column,std::decay_t<Value>>::value ||
+	(IsCSVString<Column>::value && IsCSVString<std::decay_t<Value>>::value)>{};
+
+/*
+ 	what the sidecar hook of CSVPrinter is handed for a column, text
+ 	columns get a string_view whichever string like type the caller
+ 	passed, so nothing is converted or copied, other columns the value
+*/
+template<typename Column>
+using CSVSidecarCell = std::conditional_t<IsCSVString<Column>::value,std::string_view,const Column&>;
+
+/*
+ 	string cell that is quoted only when it holds a delimeter, a quote or
+ 	a line break, quotes inside are doubled
+*/
+struct EscapedString{
+	std::string_view text;
+
+	static bool needsQuotes(std::string_view text){
+		return text.find_first_of(",\"\r\n") != std::string_view::npos;
+	}
+
+	template<typename Append>
+	static void quote(std::string_view text,Append append){
+		size_t start = 0;
+		for(size_t q = text.find('"'); q != std::string_view::npos; q = text.find('"',q + 1)){
+			append(text.substr(start,q + 1 - start));
+			start = q;
+		}
+		append(text.substr(start));
+	}
+
+	void formatTo(RowBuffer& buffer) const{
+		if(!needsQuotes(text)){
+			buffer.append(text);
+			return;
+		}
+		buffer.append('"');
+		quote(text,[&](std::string_view part){ buffer.append(part); });
+		buffer.append('"');
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& os,const EscapedString& value){
+	if(!EscapedString::needsQuotes(value.text)){
+		return os << value.text;
+	}
+	os << '"';
+	EscapedString::quote(value.text,[&](std::string_view part){ os << part; });
+	return os << '"';
+}
+
+/*
+ 	Labeled cell whose label is checked, the number never needs quotes
+*/
+template<typename Number>
+struct EscapedLabeled{
+	const Labeled<Number>& cell;
+
+	void formatTo(RowBuffer& buffer) const{
+		if(!EscapedString::needsQuotes(cell.label)){
+			cell.formatTo(buffer);
+			return;
+		}
+		buffer.append('"');
+		EscapedString::quote(cell.label,[&](std::string_view part){ buffer.append(part); });
+		buffer.appendNumber(cell.value);
+		buffer.append('"');
+	}
+};
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os,const EscapedLabeled<Number>& value){
+	if(!EscapedString::needsQuotes(value.cell.label)){
+		return os << value.cell;
+	}
+	os << '"';
+	EscapedString::quote(value.cell.label,[&](std::string_view part){ os << part; });
+	return os << value.cell.value << '"';
+}
+
+/*
+ 	widest text a cell of type T can produce, 0 when it is unbounded
+ 	a row made only of bounded cells needs one capacity check
+*/
+template<typename T>
+struct CSVCellWidth : std::integral_constant<size_t,
+	std::is_arithmetic<T>::value ? RowBuffer::maxChars<T>() : 0>{};
+
+template<typename... Columns>
+struct CSVRowWidth : std::integral_constant<size_t,
+	((CSVCellWidth<Columns>::value != 0) && ...)
+		? (CSVCellWidth<Columns>::value + ... + sizeof...(Columns)) : 0>{};
+
+/*
+ 	compile time headers, the names are constexpr char arrays with static
+ 	storage and the header line is built once as a constexpr byte block
+
+ 		static constexpr char rollNo[] = "RollNo";
+ 		static constexpr char name[]   = "Name";
+ 		CSVPrinter<Stream,int,std::string> printer(stream,CSVHeaders<rollNo,name>());
+*/
+constexpr bool isCSVHeaderName(const char* name){
+	if(*name == '\0'){
+		return false;
+	}
+	for(; *name; name++){
+		if(*name == ',' || *name == '"' || *name == '\n' || *name == '\r'){
+			return false;
+		}
+	}
+	return true;
+}
+
+template<size_t Length,const char*... Names>
+constexpr std::array<char,Length> buildCSVHeaderLine(){
+	std::array<char,Length> line{};
+	size_t position = 0;
+	for(const char* name : {Names...}){
+		for(; *name; name++){
+			line[position++] = *name;
+		}
+		line[position++] = ',';
+	}
+	line[Length - 1] = '\n';
+	return line;
+}
+
+template<const char*... Names>
+struct CSVHeaders{
+	static_assert(sizeof...(Names) > 0,"At least one header is needed");
+	static_assert((isCSVHeaderName(Names) && ...),
+		"Headers must be non empty and free of delimeters and quotes");
+
+	static constexpr size_t count  = sizeof...(Names);
+	static constexpr size_t length = ((std::char_traits<char>::length(Names) + 1) + ...);
+	static constexpr std::array<char,length> line = buildCSVHeaderLine<length,Names...>();
+};
+
+/*
+ Expansion of template parameter pack
+
+ @tparam     Stream   { description }
+ @tparam     Columns  { description }
+*/
+template<typename Stream, typename... Columns>
+class CSVPrinter{
+	static_assert((IsCSVColumn<Columns>::value && ...),
+		"Columns must be numbers, strings, FixedPoint or Labeled");
+
+	public:
+		/*
+		 constaining parameter packs to one type
+
+		 @param[in]  s        { parameter_description }
+		 @param[in]  strings  The strings
+
+		 @tparam     Strings  { description }
+		*/
+		template<typename... Strings>
+		void outputStrings(const std::string& s,const Strings&... strings) const{
+			writeColumn(s,word_delimeter);
+			outputStrings(strings...);
+		}
+
+		/**
+		 * @brief      { function_description }
+		 *
+		 * @param[in]  s     { parameter_description }
+		 */
+		void outputStrings(const std::string& s) const{
+			writeColumn(s,line_delimeter);
+			flushIfFull();
+		}
+
+		/**
+		 * @brief      writes one row, every value has to match the type of
+		 *             its column so nothing is converted on the way
+		 *
+		 * @param[in]  columns  The columns
+		 */
+		template<typename... Values>
+		void outputLine(const Values&... columns) const{
+			static_assert(sizeof...(Values) == sizeof...(Columns),
+			"Number of values must match number of columns");
+			static_assert((CSVCellMatches<Columns,Values>::value && ...),
+			"Value types must match the column types");
+			if(sidecar){
+				appendSidecar(sidecar,CSVSidecarCell<Columns>(columns)...);
+			}
+			if(buffered){
+				bufferLine(validateColoumn(columns)...);
+			}else{
+				writeLine(validateColoumn(columns)...);
+			}
+		}
+		/**
+		 * @brief      { function_description }
+		 *
+		 * @param      _stream  The stream
+		 * @param[in]  headers  The headers
+		 *
+		 * @tparam     Headers  { description }
+		 */
+		template<typename... Headers,
+			typename = std::enable_if_t<!(std::is_convertible<Headers,std::pmr::memory_resource*>::value || ...)>>
+		CSVPrinter(Stream& _stream,const Headers&... headers)
+			:_stream(_stream),headers({std::pmr::string(std::string_view(headers))...}){
+		 	static_assert(sizeof...(Headers) == sizeof...(Columns),
+            "Number of headers must match number of columns");
+		}
+
+		/**
+		 * @brief      runtime headers allocated from resource, an
+		 *             ArenaResource keeps them off the global heap
+		 *
+		 * @param      _stream   The stream
+		 * @param      resource  The memory resource for the headers
+		 * @param[in]  headers   The headers
+		 */
+		template<typename... Headers>
+		CSVPrinter(Stream& _stream,std::pmr::memory_resource* resource,const Headers&... headers)
+			:_stream(_stream),headers({std::pmr::string(std::string_view(headers),resource)...}){
+		 	static_assert(sizeof...(Headers) == sizeof...(Columns),
+            "Number of headers must match number of columns");
+		}
+
+		/**
+		 * @brief      headers known at compile time, outputHeaders writes
+		 *             the precomputed header line in one go
+		 *
+		 * @param      _stream  The stream
+		 */
+		template<const char*... Names>
+		CSVPrinter(Stream& _stream,CSVHeaders<Names...>)
+			:_stream(_stream),
+			headerLine(CSVHeaders<Names...>::line.data(),CSVHeaders<Names...>::length){
+			static_assert(sizeof...(Names) == sizeof...(Columns),
+            "Number of headers must match number of columns");
+		}
+
+		/**
+		 * @brief      writes whatever is still buffered, the sink must
+		 *             still be open when the printer goes away
+		 */
+		~CSVPrinter(){
+			flush();
+		}
+
+		/**
+		 * @brief      { function_description }
+		 */
+		void outputHeaders(){
+			if(!headerLine.empty()){
+				if(buffered){
+					buffer.append(headerLine);
+				}else{
+					_stream.write(headerLine.data(),headerLine.size());
+				}
+				flushIfFull();
+				return;
+			}
+			std::for_each(headers.begin(),headers.end()-1,
+					[=](const std::pmr::string& header){
+						writeColumn(header,word_delimeter);
+					}
+
+				);
+			writeColumn(headers.back(),line_delimeter);
+			flushIfFull();
+		}
+
+		/**
+		 * @brief      switches to the buffered mode, rows are formatted
+		 *             into one contiguous buffer and written to the sink
+		 *             whenever blockSize bytes have piled up
+		 *
+		 * @param[in]  blockSize  size of the writes issued to the sink
+		 */
+		void enableBuffering(size_t blockSize = 1 << 20){
+			buffered  = true;
+			this->blockSize = blockSize;
+			//one row of slack so a block never has to regrow
+			buffer.reserve(blockSize + blockSize / 8);
+		}
+
+		/**
+		 * @brief      writes the buffered rows to the sink, call this
+		 *             before closing the stream
+		 */
+		void flush() const{
+			buffer.flushTo(_stream);
+		}
+
+		/**
+		 * @brief      every row written from now on is also appended to
+		 *             the sidecar, e.g. a ColumnarWriter<Columns...> from
+		 *             csv_columnar.h, the sidecar has to outlive the printer
+		 */
+		template<typename Sidecar>
+		void attachSidecar(Sidecar& target){
+			sidecar = &target;
+			appendSidecar = [](void* sidecar,CSVSidecarCell<Columns>... columns){
+				static_cast<Sidecar*>(sidecar)->append(columns...);
+			};
+		}
+
+		/**
+		 * @brief      writes rows [0, rows) with the openmp threads, every
+		 *             thread formats whole chunks of rows into its own
+		 *             buffer and the chunks are written in order, so the
+		 *             output is byte for byte what outputLine would write
+		 *
+		 * @param[in]  rows       number of rows
+		 * @param[in]  rowAt      rowAt(i) returns row i as a std::tuple, it
+		 *                        is called concurrently
+		 * @param[in]  chunkRows  rows per chunk, 0 is taken as 1
+		 */
+		template<typename RowAt>
+		void outputLinesParallel(size_t rows,RowAt rowAt,size_t chunkRows = 1 << 14) const{
+			checkRowType(static_cast<const std::decay_t<decltype(rowAt(size_t()))>*>(nullptr));
+			flush();
+			//the sidecar is not thread safe, it is filled in a serial pass
+			if(sidecar){
+				for(size_t i = 0; i < rows; i++){
+					std::apply([&](const auto&... values){
+						appendSidecar(sidecar,CSVSidecarCell<Columns>(values)...);
+					},rowAt(i));
+				}
+			}
+
+			chunkRows = chunkRows ? chunkRows : 1;
+			const long chunks = static_cast<long>((rows + chunkRows - 1) / chunkRows);
+#ifdef _OPENMP
+			std::vector<RowBuffer> buffers(omp_get_max_threads());
+#else
+			std::vector<RowBuffer> buffers(1);
+#endif
+			#pragma omp parallel for ordered schedule(static,1)
+			for(long chunk = 0; chunk < chunks; chunk++){
+#ifdef _OPENMP
+				RowBuffer& local = buffers[omp_get_thread_num()];
+#else
+				RowBuffer& local = buffers[0];
+#endif
+				const size_t first = chunk * chunkRows;
+				const size_t last  = std::min(rows,first + chunkRows);
+				for(size_t i = first; i < last; i++){
+					std::apply([&](const auto&... values){
+						formatLine(local,validateColoumn(values)...);
+					},rowAt(i));
+				}
+				//only the write is serialised, the next chunks are being
+				//formatted by the other threads meanwhile
+				#pragma omp ordered
+				local.flushTo(_stream);
+			}
+		}
+
+	private:
+
+		Stream& _stream;
+		std::array<std::pmr::string,sizeof...(Columns)> headers;
+		std::string_view headerLine;
+		static constexpr char word_delimeter = ',';
+		static constexpr char line_delimeter = '\n';
+
+		bool buffered    = false;
+		size_t blockSize = 0;
+		mutable RowBuffer buffer;
+
+		void* sidecar = nullptr;
+		void (*appendSidecar)(void*,CSVSidecarCell<Columns>...) = nullptr;
+
+		/**
+		 * @brief      formats a whole row into the buffer, one flush check
+		 *             per row instead of one stream call per cell
+		 */
+		template<typename... Values>
+		void bufferLine(const Values&... values) const{
+			formatLine(buffer,values...);
+			flushIfFull();
+		}
+
+		/**
+		 * @brief      when every column has a bounded width the capacity is
+		 *             checked once for the row instead of once per cell
+		 */
+		template<typename... Values>
+		void formatLine(RowBuffer& target,const Values&... values) const{
+			if constexpr(CSVRowWidth<Columns...>::value != 0){
+				target.reserveRow(CSVRowWidth<Columns...>::value);
+				((target.appendCell<false>(values),target.append<false>(word_delimeter)),...);
+			}else{
+				((target.appendCell(values),target.append(word_delimeter)),...);
+			}
+			target.replaceLast(line_delimeter);
+		}
+
+		template<typename... Values>
+		static void checkRowType(const std::tuple<Values...>*){
+			static_assert(sizeof...(Values) == sizeof...(Columns),
+			"Number of values must match number of columns");
+			static_assert((CSVCellMatches<Columns,Values>::value && ...),
+			"Value types must match the column types");
+		}
+
+		void flushIfFull() const{
+			if(buffer.size() >= blockSize){
+				buffer.flushTo(_stream);
+			}
+		}
+
+		/**
+		 * @brief      Writes a line.
+		 *
+		 * @param[in]  value   The value
+		 * @param[in]  values  The values
+		 *
+		 * @tparam     Value   { description }
+		 * @tparam     Values  { description }
+		 */
+		template <typename Value, typename... Values>
+		void writeLine(const Value& value, const Values&... values) const{
+			writeColumn(value,word_delimeter);
+			writeLine(values...);
+		}
+
+		/**
+		 * @brief      Writes a line.
+		 *
+		 * @param[in]  value  The value
+		 *
+		 * @tparam     Value  { description }
+		 */
+		template<typename Value>
+		void writeLine(const Value& value) const{
+			writeColumn(value,line_delimeter);
+		}
+
+		/**
+		 * @brief      Writes a column.
+		 *
+		 * @param[in]  value      The value
+		 * @param[in]  delimeter  The delimeter
+		 *
+		 * @tparam     Value      { description }
+		 */
+		template<typename Value>
+		void writeColumn(const Value& value,char delimeter) const{
+			if(buffered){
+				buffer.appendCell(value);
+				buffer.append(delimeter);
+			}else if constexpr(std::is_floating_point<Value>::value){
+				//the shortest round trip form of the buffered path, not
+				//the stream's default of 6 significant digits
+				char digits[RowBuffer::maxChars<Value>()];
+				_stream.write(digits,std::to_chars(digits,digits + sizeof(digits),value).ptr - digits);
+				_stream << delimeter;
+			}else{
+				_stream << value << delimeter;
+			}
+		}
+
+		/**
+		 * @brief      picks the escaping a column needs from its type, text
+		 *             columns are checked for delimeters and quoted when
+		 *             needed, numbers and FixedPoint pass through unchecked
+		 *
+		 * @param[in]  value  The value
+		 *
+		 * @tparam     Value  { description }
+		 *
+		 * @return     the value or an escaping wrapper around it
+		 */
+		template<typename Value>
+		decltype(auto) validateColoumn(const Value& value) const{
+			using Cell = std::decay_t<Value>;
+			if constexpr(IsCSVString<Cell>::value){
+				return EscapedString{std::string_view(value)};
+			}else if constexpr(std::is_same<Cell,char>::value){
+				return EscapedString{std::string_view(&value,1)};
+			}else if constexpr(IsLabeled<Cell>::value){
+				return EscapedLabeled<typename Cell::NumberType>{value};
+			}else{
+				return (value);
+			}
+		}
+
+};
+
+/*
+ 	compares the per cell stream path, the buffered path and typed
+ 	columns on rows shaped like the check_var_temp loop
+*/
+void bench_csv_printer(size_t rows = 10000000);
+
+/*
+ 	outputLinesParallel against the serial buffered path for 1, 2, 4 ...
+ 	threads, the outputs have to be identical
+*/
+void bench_csv_parallel(size_t rows = 10000000);
+
+#endif // CSV_PRINTER_H
@@ -0,0 +1,126 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 11:02:15
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 11:02:15
+*/
+
+#include "bigHeader.h"
+#include "csv_reader.h"
+#include "var_temp.h"
+#include "stopwatch.h"
+
+#include <cstdio>
+#include <sstream>
+
+namespace{
+
+using TypedReader = CSVReader<
+	size_t,
+	Labeled<size_t>,
+	Labeled<size_t>,
+	Labeled<size_t>,
+	Labeled<size_t>>;
+
+void write_rows(const char* path,size_t rows){
+	std::ofstream csvStream(path);
+	CSVPrinter<std::ofstream,
+		size_t,
+		Labeled<size_t>,
+		Labeled<size_t>,
+		Labeled<size_t>,
+		Labeled<size_t>> printer(csvStream,"RollNo","Name","Sem","Course","Place");
+	printer.enableBuffering();
+	printer.outputHeaders();
+	for(size_t i = 0; i < rows; i++){
+		printer.outputLine(i,label("Name",i),label("Sem",i),label("Course",i),label("Place",i));
+	}
+	printer.flush();
+}
+
+/*
+ 	what the ingest side did before, one string per line and per field
+*/
+size_t read_with_getline(const char* path){
+	std::ifstream in(path);
+	std::string line;
+	std::getline(in,line);
+	size_t sum = 0;
+	while(std::getline(in,line)){
+		std::stringstream fields(line);
+		std::string field;
+		std::getline(fields,field,',');
+		sum += std::stoul(field);
+		while(std::getline(fields,field,',')){
+			sum += !field.empty();
+		}
+	}
+	return sum;
+}
+
+size_t read_with_reader(const char* path,size_t& bytes){
+	TypedReader reader(path,"RollNo","Name","Sem","Course","Place");
+	bytes = reader.bytes();
+	size_t sum = 0;
+	reader.forEachRow([&](const TypedReader::Row& row){
+		sum += std::get<0>(row);
+		sum += !std::get<1>(row).label.empty() + !std::get<2>(row).label.empty() +
+			!std::get<3>(row).label.empty() + !std::get<4>(row).label.empty();
+	});
+	return sum;
+}
+
+}
+
+void check_csv_reader(){
+	check_var_temp();
+
+	CSVReader<int,Labeled<int>,Labeled<int>,Labeled<int>,Labeled<int>>
+		reader("csv.txt","RollNo","Name","Sem","Course","Place");
+	int expected = 0;
+	reader.forEachRow([&](const std::tuple<int,Labeled<int>,Labeled<int>,Labeled<int>,Labeled<int>>& row){
+		const bool same = std::get<0>(row) == expected &&
+			std::get<1>(row).label == "Name" && std::get<1>(row).value == expected &&
+			std::get<2>(row).label == "Sem" && std::get<2>(row).value == expected &&
+			std::get<3>(row).label == "Course" && std::get<3>(row).value == expected &&
+			std::get<4>(row).label == "Place" && std::get<4>(row).value == expected;
+		if(!same){
+			throw std::runtime_error("csv.txt row " + std::to_string(expected) + " did not round trip");
+		}
+		expected++;
+	});
+
+	/*
+	 	the same file through zero copy string columns
+	 */
+	CSVReader<std::string_view,std::string_view,std::string_view,std::string_view,std::string_view>
+		views("csv.txt","RollNo","Name","Sem","Course","Place");
+	std::tuple<std::string_view,std::string_view,std::string_view,std::string_view,std::string_view> row;
+	views.readRow(row);
+
+	std::cout << std::endl << "csv.txt round trip: " << expected << " rows, first name "
+		<< std::get<1>(row) << std::endl;
+}
+
+void bench_csv_reader(size_t rows){
+	const char* path = "csv_read_bench.txt";
+	write_rows(path,rows);
+
+	Stopwatch watch;
+	size_t bytes = 0;
+	const size_t mapped = read_with_reader(path,bytes);
+	const double reader_seconds = watch.seconds();
+
+	watch.reset();
+	const size_t streamed = read_with_getline(path);
+	const double getline_seconds = watch.seconds();
+
+	const double gigabytes = bytes / 1e9;
+	std::cout << "CSVReader         : " << gigabytes / reader_seconds << " GB/s ("
+		<< reader_seconds << " s)" << std::endl;
+	std::cout << "getline + sstream : " << gigabytes / getline_seconds << " GB/s ("
+		<< getline_seconds << " s)" << std::endl;
+	std::cout << "checksums " << mapped << " " << streamed << std::endl;
+
+	std::remove(path);
+}
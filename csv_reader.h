@@ -0,0 +1,291 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include "bigHeader.h"
+#include "csv_printer.h"
+#include "mapped_file.h"
+#include "csv_simd.h"
+
+/*
+ 	field parsers, one overload for every column type CSVPrinter can write
+ 	fields arrive as raw views into the mapped file, quotes included
+*/
+
+/**
+ * @brief      strips the outer quotes of a quoted field
+ */
+inline std::string_view unquote(std::string_view field){
+	if(field.size() >= 2 && field.front() == '"' && field.back() == '"'){
+		return field.substr(1,field.size() - 2);
+	}
+	return field;
+}
+
+/**
+ * @brief      zero copy, the view points into the mapped file, escaped
+ *             quotes inside a quoted field stay doubled
+ */
+inline bool parseField(std::string_view field,std::string_view& out){
+	out = unquote(field);
+	return true;
+}
+
+/**
+ * @brief      copying string column, escaped quotes are undoubled
+ *             std::pmr::string columns allocate from their own resource
+ */
+template<typename Allocator>
+bool parseField(std::string_view field,std::basic_string<char,std::char_traits<char>,Allocator>& out){
+	const bool quoted = field.size() >= 2 && field.front() == '"';
+	field = unquote(field);
+	out.assign(field.data(),field.size());
+	if(quoted){
+		for(size_t i = out.find("\"\""); i != out.npos; i = out.find("\"\"",i + 1)){
+			out.erase(i,1);
+		}
+	}
+	return true;
+}
+
+inline bool parseField(std::string_view field,bool& out){
+	field = unquote(field);
+	if(field.size() != 1 || (field[0] != '0' && field[0] != '1')){
+		return false;
+	}
+	out = field[0] == '1';
+	return true;
+}
+
+template<typename Number>
+std::enable_if_t<std::is_arithmetic<Number>::value,bool>
+parseField(std::string_view field,Number& out){
+	field = unquote(field);
+	const auto result = std::from_chars(field.data(),field.data() + field.size(),out);
+	return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+template<unsigned Decimals>
+bool parseField(std::string_view field,FixedPoint<Decimals>& out){
+	field = unquote(field);
+	const bool negative = !field.empty() && field.front() == '-';
+	if(negative){
+		field.remove_prefix(1);
+	}
+	const size_t dot = field.find('.');
+	unsigned long long whole = 0;
+	const std::string_view integer = field.substr(0,dot);
+	const auto result = std::from_chars(integer.data(),integer.data() + integer.size(),whole);
+	if(result.ec != std::errc() || result.ptr != integer.data() + integer.size()){
+		return false;
+	}
+	unsigned long long fraction = 0;
+	size_t digits = 0;
+	if(dot != std::string_view::npos){
+		for(const char c : field.substr(dot + 1)){
+			if(c < '0' || c > '9' || ++digits > Decimals){
+				return false;
+			}
+			fraction = fraction * 10 + (c - '0');
+		}
+	}
+	for(; digits < Decimals; digits++){
+		fraction *= 10;
+	}
+	const unsigned long long magnitude = whole * FixedPoint<Decimals>::scale() + fraction;
+	out.scaled = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+	return true;
+}
+
+/**
+ * @brief      splits Name5 back into its label and number, the label is a
+ *             view into the mapped file
+ */
+template<typename Number>
+bool parseField(std::string_view field,Labeled<Number>& out){
+	field = unquote(field);
+	size_t split = field.size();
+	while(split > 0 && ((field[split - 1] >= '0' && field[split - 1] <= '9') ||
+		field[split - 1] == '.' || field[split - 1] == '-')){
+		split--;
+	}
+	out.label = field.substr(0,split);
+	return parseField(field.substr(split),out.value);
+}
+
+/*
+ 	reads back what CSVPrinter<Stream, Columns...> writes, the file is
+ 	memory mapped, split with the simd structural index and fields are
+ 	handed to the parsers as string_views so string_view columns stay
+ 	valid as long as the reader lives
+*/
+template<typename... Columns>
+class CSVReader{
+	static_assert((IsCSVColumn<Columns>::value && ...),
+		"Columns must be numbers, strings, FixedPoint or Labeled");
+	static_assert(((!std::is_pointer<Columns>::value) && ...),
+		"Use std::string_view for zero copy string columns, fields are not null terminated");
+
+	public:
+		using Row = std::tuple<Columns...>;
+
+		/**
+		 * @brief      maps the file and checks its header line
+		 *
+		 * @param[in]  path     The path
+		 * @param[in]  headers  The expected headers
+		 */
+		template<typename... Headers>
+		CSVReader(const std::string& path,const Headers&... headers)
+			:file(path),headers({std::string(headers)...}){
+			static_assert(sizeof...(Headers) == sizeof...(Columns),
+            "Number of headers must match number of columns");
+			cursor  = file.data();
+			end     = file.data() + file.size();
+			scanned = cursor;
+			validateHeaders();
+		}
+
+		/**
+		 * @brief      parses the next row into row
+		 *
+		 * @return     false once the file is exhausted
+		 */
+		bool readRow(Row& row){
+			if(cursor >= end){
+				return false;
+			}
+			line++;
+			parseRow(row,std::index_sequence_for<Columns...>());
+			return true;
+		}
+
+		/**
+		 * @brief      calls f for every remaining row
+		 *
+		 * @return     number of rows read
+		 */
+		template<typename Func>
+		size_t forEachRow(Func f){
+			Row row;
+			size_t rows = 0;
+			while(readRow(row)){
+				f(row);
+				rows++;
+			}
+			return rows;
+		}
+
+		size_t bytes() const{
+			return file.size();
+		}
+
+	private:
+		MappedFile file;
+		std::array<std::string,sizeof...(Columns)> headers;
+		const char* cursor = nullptr;
+		const char* end    = nullptr;
+		size_t line        = 1;
+
+		static constexpr size_t windowSize = 1 << 20;
+		StructuralScanner scanner;
+		std::vector<uint32_t> index;
+		size_t next            = 0;
+		const char* window     = nullptr;
+		const char* scanned    = nullptr;
+
+		/**
+		 * @brief      returns the field at the cursor and moves past its
+		 *             terminator, the structural index already skips
+		 *             delimeters inside quoted fields
+		 */
+		std::string_view nextField(char& terminator){
+			const char* begin = cursor;
+			const char* structural = nextStructural();
+			if(structural){
+				terminator = *structural;
+				cursor = structural + 1;
+			}else{
+				terminator = '\n';
+				structural = cursor = end;
+			}
+			std::string_view field(begin,structural - begin);
+			if(terminator == '\n' && !field.empty() && field.back() == '\r'){
+				field.remove_suffix(1);
+			}
+			return field;
+		}
+
+		/**
+		 * @brief      next unquoted , or \n, the file is indexed one
+		 *             window at a time so the index stays small
+		 */
+		const char* nextStructural(){
+			while(next == index.size()){
+				if(scanned == end){
+					return nullptr;
+				}
+				const size_t size = std::min<size_t>(windowSize,end - scanned);
+				index.clear();
+				next   = 0;
+				window = scanned;
+				scanner.scan(scanned,size,index);
+				scanned += size;
+			}
+			return window + index[next++];
+		}
+
+		template<size_t... Is>
+		void parseRow(Row& row,std::index_sequence<Is...>){
+			(parseColumn<Is>(std::get<Is>(row)),...);
+		}
+
+		template<size_t I,typename Value>
+		void parseColumn(Value& value){
+			char terminator;
+			const std::string_view field = nextField(terminator);
+			checkTerminator(terminator,I + 1 == sizeof...(Columns));
+			if(!parseField(field,value)){
+				fail("cannot parse " + headers[I] + " from '" + std::string(field) + "'");
+			}
+		}
+
+		void checkTerminator(char terminator,bool last) const{
+			if(last && terminator != '\n'){
+				fail("too many columns");
+			}
+			if(!last && terminator == '\n'){
+				fail("too few columns");
+			}
+		}
+
+		/**
+		 * @brief      the header line has to name exactly the expected
+		 *             columns in order
+		 */
+		void validateHeaders(){
+			for(size_t i = 0; i < headers.size(); i++){
+				char terminator;
+				const std::string_view field = unquote(nextField(terminator));
+				if(field != headers[i]){
+					fail("expected header " + headers[i] + " but found '" + std::string(field) + "'");
+				}
+				checkTerminator(terminator,i + 1 == headers.size());
+			}
+		}
+
+		[[noreturn]] void fail(const std::string& what) const{
+			throw std::runtime_error("csv line " + std::to_string(line) + ": " + what);
+		}
+};
+
+/*
+ 	reads csv.txt as written by check_var_temp and checks every value
+*/
+void check_csv_reader();
+
+/*
+ 	throughput of CSVReader against std::getline + stringstream splitting
+*/
+void bench_csv_reader(size_t rows = 10000000);
+
+#endif // CSV_READER_H
@@ -0,0 +1,257 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 12:20:41
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 12:20:41
+*/
+
+#include "bigHeader.h"
+#include "csv_simd.h"
+#include "csv_printer.h"
+
+#include <cstring>
+#include <immintrin.h>
+#include <sstream>
+
+namespace{
+
+/*
+ 	bit i of the result is the xor of bits 0..i of quotes, so it is set
+ 	from an opening quote up to (not including) the closing one
+*/
+inline uint64_t prefixXor(uint64_t quotes){
+	quotes ^= quotes << 1;
+	quotes ^= quotes << 2;
+	quotes ^= quotes << 4;
+	quotes ^= quotes << 8;
+	quotes ^= quotes << 16;
+	quotes ^= quotes << 32;
+	return quotes;
+}
+
+/*
+ 	shared tail of every kernel, masks out quoted delimeters and writes
+ 	the offsets of the remaining bits
+*/
+inline void emitBlock(uint64_t commas,uint64_t newlines,uint64_t quotes,
+	uint32_t offset,uint64_t& inQuote,std::vector<uint32_t>& out){
+	const uint64_t quoted = prefixXor(quotes) ^ inQuote;
+	inQuote = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+	uint64_t structurals = (commas | newlines) & ~quoted;
+	while(structurals){
+		out.push_back(offset + static_cast<uint32_t>(__builtin_ctzll(structurals)));
+		structurals &= structurals - 1;
+	}
+}
+
+void scanScalar(const char* data,size_t blocks,uint32_t base,
+	uint64_t& inQuote,std::vector<uint32_t>& out){
+	for(size_t block = 0; block < blocks; block++){
+		const char* bytes = data + block * 64;
+		uint64_t commas = 0,newlines = 0,quotes = 0;
+		for(unsigned i = 0; i < 64; i++){
+			const uint64_t bit = 1ULL << i;
+			commas   |= bytes[i] == ',' ? bit : 0;
+			newlines |= bytes[i] == '\n' ? bit : 0;
+			quotes   |= bytes[i] == '"' ? bit : 0;
+		}
+		emitBlock(commas,newlines,quotes,base + block * 64,inQuote,out);
+	}
+}
+
+__attribute__((target("sse2")))
+uint64_t matchSSE(const char* bytes,char c){
+	const __m128i needle = _mm_set1_epi8(c);
+	uint64_t mask = 0;
+	for(unsigned i = 0; i < 4; i++){
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i * 16));
+		mask |= static_cast<uint64_t>(static_cast<uint16_t>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(chunk,needle)))) << (i * 16);
+	}
+	return mask;
+}
+
+__attribute__((target("sse2")))
+void scanSSE2(const char* data,size_t blocks,uint32_t base,
+	uint64_t& inQuote,std::vector<uint32_t>& out){
+	for(size_t block = 0; block < blocks; block++){
+		const char* bytes = data + block * 64;
+		emitBlock(matchSSE(bytes,','),matchSSE(bytes,'\n'),matchSSE(bytes,'"'),
+			base + block * 64,inQuote,out);
+	}
+}
+
+__attribute__((target("avx2")))
+uint64_t matchAVX2(__m256i low,__m256i high,char c){
+	const __m256i needle = _mm256_set1_epi8(c);
+	const uint64_t lowMask  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low,needle)));
+	const uint64_t highMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high,needle)));
+	return lowMask | (highMask << 32);
+}
+
+__attribute__((target("avx2")))
+void scanAVX2(const char* data,size_t blocks,uint32_t base,
+	uint64_t& inQuote,std::vector<uint32_t>& out){
+	for(size_t block = 0; block < blocks; block++){
+		const char* bytes = data + block * 64;
+		const __m256i low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+		const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32));
+		emitBlock(matchAVX2(low,high,','),matchAVX2(low,high,'\n'),matchAVX2(low,high,'"'),
+			base + block * 64,inQuote,out);
+	}
+}
+
+}
+
+bool scanKernelSupported(ScanKernel kernel){
+	switch(kernel){
+		case ScanKernel::AVX2:
+			return __builtin_cpu_supports("avx2");
+		case ScanKernel::SSE2:
+			return __builtin_cpu_supports("sse2");
+		default:
+			return true;
+	}
+}
+
+ScanKernel bestScanKernel(){
+	static const ScanKernel best =
+		scanKernelSupported(ScanKernel::AVX2) ? ScanKernel::AVX2 :
+		scanKernelSupported(ScanKernel::SSE2) ? ScanKernel::SSE2 :
+		ScanKernel::Scalar;
+	return best;
+}
+
+const char* scanKernelName(ScanKernel kernel){
+	switch(kernel){
+		case ScanKernel::AVX2:
+			return "avx2";
+		case ScanKernel::SSE2:
+			return "sse2";
+		default:
+			return "scalar";
+	}
+}
+
+StructuralScanner::StructuralScanner(ScanKernel kernel):_kernel(kernel){
+	if(!scanKernelSupported(kernel)){
+		throw std::runtime_error(std::string("cpu does not support the ") +
+			scanKernelName(kernel) + " kernel");
+	}
+	switch(kernel){
+		case ScanKernel::AVX2:
+			scanBlocks = scanAVX2;
+			break;
+		case ScanKernel::SSE2:
+			scanBlocks = scanSSE2;
+			break;
+		default:
+			scanBlocks = scanScalar;
+			break;
+	}
+}
+
+void StructuralScanner::scan(const char* data,size_t size,std::vector<uint32_t>& out){
+	const size_t blocks = size / 64;
+	scanBlocks(data,blocks,0,inQuote,out);
+
+	//the tail goes through the same kernel from a zero padded block
+	const size_t tail = size % 64;
+	if(tail){
+		alignas(64) char padded[64] = {};
+		std::memcpy(padded,data + blocks * 64,tail);
+		scanBlocks(padded,1,static_cast<uint32_t>(blocks * 64),inQuote,out);
+	}
+}
+
+namespace{
+
+/*
+ 	byte at a time reference the kernels are checked against
+*/
+std::vector<uint32_t> reference_index(const std::string& text){
+	std::vector<uint32_t> out;
+	bool quoted = false;
+	for(size_t i = 0; i < text.size(); i++){
+		if(text[i] == '"'){
+			quoted = !quoted;
+		}else if(!quoted && (text[i] == ',' || text[i] == '\n')){
+			out.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	return out;
+}
+
+/*
+ 	scans in windows of 64 bytes as well so the quote carry is exercised
+*/
+std::vector<uint32_t> kernel_index(ScanKernel kernel,const std::string& text,size_t window){
+	StructuralScanner scanner(kernel);
+	std::vector<uint32_t> out,part;
+	for(size_t start = 0; start < text.size(); start += window){
+		part.clear();
+		scanner.scan(text.data() + start,std::min(window,text.size() - start),part);
+		for(const uint32_t offset : part){
+			out.push_back(static_cast<uint32_t>(start) + offset);
+		}
+	}
+	return out;
+}
+
+std::vector<std::string> sample_inputs(){
+	std::vector<std::string> inputs;
+
+	//rows as check_var_temp writes them
+	std::ostringstream rows;
+	CSVPrinter<std::ostringstream,int,Labeled<int>,Labeled<int>,Labeled<int>,Labeled<int>>
+		printer(rows,"RollNo","Name","Sem","Course","Place");
+	printer.outputHeaders();
+	for(int i = 0; i < 500; i++){
+		printer.outputLine(i,label("Name",i),label("Sem",i),label("Course",i),label("Place",i));
+	}
+	inputs.push_back(rows.str());
+
+	//quoted fields with delimeters, escaped quotes and empty fields
+	inputs.push_back("a,\"b,c\",d\n\"x\ny\",\"\"\"\",\n,,\"\"\n");
+	inputs.push_back(std::string(63,'a') + "\"," + std::string(70,',') + "\"\n,");
+	inputs.push_back("\"" + std::string(200,',') + "\n\"," + std::string(130,'\n'));
+	inputs.push_back("");
+	inputs.push_back("\"unterminated,quote\nstays,open");
+
+	//pseudo random mixes of the interesting bytes, every length up to 300
+	const char alphabet[] = {',','\n','"','a','"',','};
+	unsigned seed = 2358;
+	for(size_t length = 1; length <= 300; length++){
+		std::string text(length,' ');
+		for(char& c : text){
+			seed = seed * 1103515245 + 12345;
+			c = alphabet[(seed >> 16) % sizeof(alphabet)];
+		}
+		inputs.push_back(text);
+	}
+	return inputs;
+}
+
+}
+
+void check_csv_simd(){
+	const ScanKernel kernels[] = {ScanKernel::Scalar,ScanKernel::SSE2,ScanKernel::AVX2};
+	const std::vector<std::string> inputs = sample_inputs();
+
+	for(const ScanKernel kernel : kernels){
+		if(!scanKernelSupported(kernel)){
+			std::cout << scanKernelName(kernel) << ": not supported, skipped" << std::endl;
+			continue;
+		}
+		for(size_t i = 0; i < inputs.size(); i++){
+			const std::vector<uint32_t> expected = reference_index(inputs[i]);
+			if(kernel_index(kernel,inputs[i],1 << 20) != expected ||
+				kernel_index(kernel,inputs[i],64) != expected){
+				throw std::runtime_error(std::string(scanKernelName(kernel)) +
+					" kernel differs from the scalar index on input " + std::to_string(i));
+			}
+		}
+		std::cout << scanKernelName(kernel) << ": " << inputs.size() << " inputs match" << std::endl;
+	}
+	std::cout << "runtime kernel: " << scanKernelName(bestScanKernel()) << std::endl;
+}
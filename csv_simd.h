@@ -0,0 +1,74 @@
+#ifndef CSV_SIMD_H
+#define CSV_SIMD_H
+
+#include "bigHeader.h"
+#include <cstdint>
+
+/*
+ 	structural index for csv text in the style of simdjson
+ 	every 64 byte block is turned into bitmaps of , \n and "
+ 	the quote bitmap is prefix xor'ed into an "inside quotes" mask and
+ 	the offsets of the delimeters outside quotes are written out
+*/
+enum class ScanKernel{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+/**
+ * @brief      the widest kernel the cpu supports, decided with cpuid
+ */
+ScanKernel bestScanKernel();
+
+/**
+ * @brief      true when the running cpu can execute the kernel
+ */
+bool scanKernelSupported(ScanKernel kernel);
+
+const char* scanKernelName(ScanKernel kernel);
+
+class StructuralScanner{
+	public:
+		explicit StructuralScanner(ScanKernel kernel = bestScanKernel());
+
+		/**
+		 * @brief      appends the offsets (relative to data) of every , and
+		 *             \n outside a quoted field, the quote state carries
+		 *             over to the next call so a buffer can be scanned in
+		 *             windows, every window but the last has to be a
+		 *             multiple of 64 bytes
+		 *
+		 * @param[in]  data  The data
+		 * @param[in]  size  The size
+		 * @param      out   The offsets
+		 */
+		void scan(const char* data,size_t size,std::vector<uint32_t>& out);
+
+		/**
+		 * @brief      forgets the quote state, for reuse on a new buffer
+		 */
+		void reset(){
+			inQuote = 0;
+		}
+
+		ScanKernel kernel() const{
+			return _kernel;
+		}
+
+	private:
+		using BlockScan = void(*)(const char* data,size_t blocks,uint32_t base,
+			uint64_t& inQuote,std::vector<uint32_t>& out);
+
+		ScanKernel _kernel;
+		BlockScan scanBlocks;
+		uint64_t inQuote = 0;
+};
+
+/*
+ 	checks that every kernel the cpu supports produces the same index as
+ 	the scalar one, on csv.txt style rows and on quoted adversarial input
+*/
+void check_csv_simd();
+
+#endif // CSV_SIMD_H
@@ -0,0 +1,190 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 22:18:37
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 22:18:37
+*/
+
+#include "bigHeader.h"
+#include "expr_vector.h"
+#include "heap_counter.h"
+#include "stopwatch.h"
+
+#include <cmath>
+
+namespace{
+
+void expect_equal(const ExprVector& actual,const std::vector<double>& expected,const char* what){
+	if(actual.size() != expected.size()){
+		throw std::runtime_error(std::string("expr vector check failed, size of ") + what);
+	}
+	for(size_t i = 0; i < expected.size(); i++){
+		if(std::fabs(actual[i] - expected[i]) > 1e-9){
+			throw std::runtime_error(std::string("expr vector check failed, element ")
+				+ std::to_string(i) + " of " + what);
+		}
+	}
+}
+
+}
+
+void check_expr_vector(){
+	//sizes around the four lane batches exercise the scalar tail
+	for(size_t n : {0,1,3,4,5,8,13,1001}){
+		ExprVector a(n),b(n),c(n),d(n);
+		std::vector<double> sum(n),mixed(n);
+		for(size_t i = 0; i < n; i++){
+			a[i] = i * 0.5;
+			b[i] = 1.0 + i;
+			c[i] = 2.0 - i * 0.25;
+			d[i] = i % 7;
+			sum[i] = a[i] + b[i] + c[i] + d[i];
+			mixed[i] = a[i] * b[i] - 3.0 * c[i] * d[i];
+		}
+		expect_equal(a + b + c + d,sum,"a + b + c + d");
+		expect_equal(a * b - 3.0 * c * d,mixed,"a * b - 3.0 * c * d");
+
+		//a tree kept in a variable holds its nested nodes by value
+		auto tree = (a + b) + (c + d);
+		ExprVector fromTree = tree;
+		expect_equal(fromTree,sum,"stored tree");
+
+		a += b + c + d;
+		expect_equal(a,sum,"a += b + c + d");
+	}
+
+	ExprVector a(1000,1.0),b(1000,2.0),result(1000);
+	const HeapCounters before = heapCounters();
+	result = a + b + a + b;
+	result += 2.0 * a;
+	const HeapCounters traffic = heapCounters() - before;
+	if(traffic.allocations != 0){
+		throw std::runtime_error("expr vector check failed, assignment allocated a temporary");
+	}
+
+	bool rejected = false;
+	try{
+		ExprVector shorter(999);
+		result = a + shorter;
+	}catch(const std::invalid_argument&){
+		rejected = true;
+	}
+	if(!rejected){
+		throw std::runtime_error("expr vector check failed, mismatched sizes were accepted");
+	}
+	std::cout << "expr vector check passed" << std::endl;
+}
+
+namespace{
+
+/*
+ 	MyOperator's operator+ on a vector, the const & overload copies the
+ 	left operand and the && overload reuses it, so a + b + c + d makes one
+ 	temporary and walks memory three times
+*/
+class EagerVector{
+	public:
+		EagerVector(size_t size,double value):values(size,value){
+
+		}
+
+		EagerVector& operator+=(const EagerVector& other){
+			for(size_t i = 0; i < values.size(); i++){
+				values[i] += other.values[i];
+			}
+			return *this;
+		}
+
+		EagerVector& operator*=(const EagerVector& other){
+			for(size_t i = 0; i < values.size(); i++){
+				values[i] *= other.values[i];
+			}
+			return *this;
+		}
+
+		EagerVector operator+(const EagerVector& other) const &{
+			EagerVector m(*this);
+			m += other;
+			return m;
+		}
+
+		EagerVector operator+(const EagerVector& other) &&{
+			*this += other;
+			return std::move(*this);
+		}
+
+		EagerVector operator*(const EagerVector& other) const &{
+			EagerVector m(*this);
+			m *= other;
+			return m;
+		}
+
+		EagerVector operator*(const EagerVector& other) &&{
+			*this *= other;
+			return std::move(*this);
+		}
+
+		double operator[](size_t i) const{
+			return values[i];
+		}
+
+	private:
+		std::vector<double> values;
+};
+
+/**
+ * @brief      the fused loop without AVX, one element per step
+ */
+template<typename E>
+void assign_scalar(ExprVector& out,const VecExpr<E>& expression){
+	const E& e = expression.self();
+	for(size_t i = 0; i < out.size(); i++){
+		out[i] = e[i];
+	}
+}
+
+template<typename Run>
+double ns_per_element(size_t size,size_t rounds,Run run){
+	Stopwatch watch;
+	for(size_t r = 0; r < rounds; r++){
+		run();
+	}
+	return watch.nanoseconds() / static_cast<double>(size * rounds);
+}
+
+}
+
+void bench_expr_vector(size_t size,size_t rounds){
+	EagerVector ea(size,1.0),eb(size,2.0),ec(size,3.0),ed(size,4.0);
+	EagerVector eagerResult(size,0.0);
+	ExprVector a(size,1.0),b(size,2.0),c(size,3.0),d(size,4.0);
+	ExprVector result(size);
+
+	std::cout << size << " doubles, " << rounds << " rounds, ns per element" << std::endl;
+
+	std::cout << "a + b + c + d" << std::endl;
+	std::cout << "  MyOperator chain: " << ns_per_element(size,rounds,[&]{
+		eagerResult = ea + eb + ec + ed;
+	}) << std::endl;
+	std::cout << "  fused scalar    : " << ns_per_element(size,rounds,[&]{
+		assign_scalar(result,a + b + c + d);
+	}) << std::endl;
+	std::cout << "  fused avx       : " << ns_per_element(size,rounds,[&]{
+		result = a + b + c + d;
+	}) << std::endl;
+
+	std::cout << "a * b + c * d" << std::endl;
+	std::cout << "  MyOperator chain: " << ns_per_element(size,rounds,[&]{
+		eagerResult = ea * eb + ec * ed;
+	}) << std::endl;
+	std::cout << "  fused scalar    : " << ns_per_element(size,rounds,[&]{
+		assign_scalar(result,a * b + c * d);
+	}) << std::endl;
+	std::cout << "  fused avx       : " << ns_per_element(size,rounds,[&]{
+		result = a * b + c * d;
+	}) << std::endl;
+
+	if(result[size / 2] != eagerResult[size / 2]){
+		throw std::runtime_error("expr vector bench: fused and chained results differ");
+	}
+}
@@ -0,0 +1,254 @@
+#ifndef EXPR_VECTOR_H
+#define EXPR_VECTOR_H
+
+#include "bigHeader.h"
+
+#include <immintrin.h>
+#include <initializer_list>
+#include <type_traits>
+
+/*
+ 	expression templates, MyOperator generalized to vectors of doubles
+
+ 	a + b + c + d does not compute anything, it builds a small tree of
+ 	nodes that remember their operands, assigning the tree to an
+ 	ExprVector runs one fused loop that reads every operand once per
+ 	element and writes the result once, no intermediate vectors
+ 	the loop takes four doubles at a time through AVX, every node can
+ 	hand out element i as a double or elements i..i+3 as a __m256d
+
+ 		ExprVector a(n,1.0),b(n,2.0),c(n,3.0),d(n,4.0);
+ 		ExprVector sum = a + b + c + d;	//one pass over n elements
+ 		sum += 2.0 * a;
+*/
+template<typename E>
+struct VecExpr{
+	const E& self() const{
+		return static_cast<const E&>(*this);
+	}
+};
+
+class ExprVector;
+
+/*
+ 	vectors are held by reference, they outlive the statement that uses
+ 	them, nested nodes are temporaries and are held by value so a tree
+ 	kept in an auto variable does not dangle
+*/
+template<typename E>
+using ExprOperand = std::conditional_t<std::is_same<E,ExprVector>::value,const ExprVector&,const E>;
+
+namespace expr_ops{
+
+struct Add{
+	static double apply(double a,double b){
+		return a + b;
+	}
+
+	static __m256d apply(__m256d a,__m256d b){
+		return _mm256_add_pd(a,b);
+	}
+};
+
+struct Subtract{
+	static double apply(double a,double b){
+		return a - b;
+	}
+
+	static __m256d apply(__m256d a,__m256d b){
+		return _mm256_sub_pd(a,b);
+	}
+};
+
+struct Multiply{
+	static double apply(double a,double b){
+		return a * b;
+	}
+
+	static __m256d apply(__m256d a,__m256d b){
+		return _mm256_mul_pd(a,b);
+	}
+};
+
+}
+
+/*
+ 	element wise op of two expressions of the same size
+*/
+template<typename L,typename R,typename Op>
+class VecBinary : public VecExpr<VecBinary<L,R,Op>>{
+	public:
+		VecBinary(const L& left,const R& right):left(left),right(right){
+			if(left.size() != right.size()){
+				throw std::invalid_argument("vector expression: sizes " + std::to_string(left.size())
+					+ " and " + std::to_string(right.size()) + " do not match");
+			}
+		}
+
+		size_t size() const{
+			return left.size();
+		}
+
+		double operator[](size_t i) const{
+			return Op::apply(left[i],right[i]);
+		}
+
+		__m256d batch(size_t i) const{
+			return Op::apply(left.batch(i),right.batch(i));
+		}
+
+	private:
+		ExprOperand<L> left;
+		ExprOperand<R> right;
+};
+
+/*
+ 	scalar times an expression
+*/
+template<typename E>
+class VecScaled : public VecExpr<VecScaled<E>>{
+	public:
+		VecScaled(double factor,const E& expression):factor(factor),expression(expression){
+
+		}
+
+		size_t size() const{
+			return expression.size();
+		}
+
+		double operator[](size_t i) const{
+			return factor * expression[i];
+		}
+
+		__m256d batch(size_t i) const{
+			return _mm256_mul_pd(_mm256_set1_pd(factor),expression.batch(i));
+		}
+
+	private:
+		double factor;
+		ExprOperand<E> expression;
+};
+
+/*
+ 	the vector the expressions are evaluated into
+*/
+class ExprVector : public VecExpr<ExprVector>{
+	public:
+		static constexpr size_t lanes = sizeof(__m256d) / sizeof(double);
+
+		ExprVector() = default;
+
+		explicit ExprVector(size_t size,double value = 0.0):values(size,value){
+
+		}
+
+		ExprVector(std::initializer_list<double> values):values(values){
+
+		}
+
+		/**
+		 * @brief      evaluates expression in one fused pass
+		 */
+		template<typename E>
+		ExprVector(const VecExpr<E>& expression):values(expression.self().size()){
+			assign(expression.self());
+		}
+
+		template<typename E>
+		ExprVector& operator=(const VecExpr<E>& expression){
+			//every element only reads its own index, so v = v + w is safe
+			values.resize(expression.self().size());
+			assign(expression.self());
+			return *this;
+		}
+
+		template<typename E>
+		ExprVector& operator+=(const VecExpr<E>& expression);
+
+		size_t size() const{
+			return values.size();
+		}
+
+		double operator[](size_t i) const{
+			return values[i];
+		}
+
+		double& operator[](size_t i){
+			return values[i];
+		}
+
+		__m256d batch(size_t i) const{
+			return _mm256_loadu_pd(values.data() + i);
+		}
+
+		const double* data() const{
+			return values.data();
+		}
+
+		double* data(){
+			return values.data();
+		}
+
+	private:
+		std::vector<double> values;
+
+		template<typename E>
+		void assign(const E& expression){
+			const size_t n = values.size();
+			double* out = values.data();
+			size_t i = 0;
+			for(; i + lanes <= n; i += lanes){
+				_mm256_storeu_pd(out + i,expression.batch(i));
+			}
+			for(; i < n; i++){
+				out[i] = expression[i];
+			}
+		}
+};
+
+template<typename L,typename R>
+VecBinary<L,R,expr_ops::Add> operator+(const VecExpr<L>& left,const VecExpr<R>& right){
+	return VecBinary<L,R,expr_ops::Add>(left.self(),right.self());
+}
+
+template<typename L,typename R>
+VecBinary<L,R,expr_ops::Subtract> operator-(const VecExpr<L>& left,const VecExpr<R>& right){
+	return VecBinary<L,R,expr_ops::Subtract>(left.self(),right.self());
+}
+
+/**
+ * @brief      element wise product
+ */
+template<typename L,typename R>
+VecBinary<L,R,expr_ops::Multiply> operator*(const VecExpr<L>& left,const VecExpr<R>& right){
+	return VecBinary<L,R,expr_ops::Multiply>(left.self(),right.self());
+}
+
+template<typename E>
+VecScaled<E> operator*(double factor,const VecExpr<E>& expression){
+	return VecScaled<E>(factor,expression.self());
+}
+
+template<typename E>
+VecScaled<E> operator*(const VecExpr<E>& expression,double factor){
+	return VecScaled<E>(factor,expression.self());
+}
+
+template<typename E>
+ExprVector& ExprVector::operator+=(const VecExpr<E>& expression){
+	return *this = *this + expression;
+}
+
+/*
+ 	fused results against element wise loops, sizes that do not fill the
+ 	last AVX batch, mismatched sizes and zero heap traffic on assignment
+*/
+void check_expr_vector();
+
+/*
+ 	a + b + c + d and a * b + c * d, a vector with MyOperator's ref
+ 	qualified operator+ against the fused expression, scalar and AVX
+*/
+void bench_expr_vector(size_t size = 1000000,size_t rounds = 100);
+
+#endif // EXPR_VECTOR_H
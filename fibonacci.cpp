@@ -0,0 +1,136 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 17:02:18
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 17:02:18
+*/
+
+#include "bigHeader.h"
+#include "fibonacci.h"
+#include "stopwatch.h"
+
+uint128_t fibonacci(unsigned n){
+	if(n < fibonacciTableSize){
+		return fibonacciTable[n];
+	}
+	uint128_t value = 0;
+	if(!fibonacci_checked(n,value)){
+		throw std::overflow_error("F(" + std::to_string(n) + ") does not fit in 128 bits");
+	}
+	return value;
+}
+
+std::string to_string(uint128_t value){
+	char digits[40];
+	char* end   = digits + sizeof(digits);
+	char* begin = end;
+	do{
+		*--begin = static_cast<char>('0' + static_cast<unsigned>(value % 10));
+		value /= 10;
+	}while(value);
+	return std::string(begin,end);
+}
+
+namespace{
+
+/*
+ 	the two versions the engine replaces, kept as the benchmark baseline
+*/
+std::function<long(int)> recursive_fibonacci = [](int n)-> long{
+	if(n < 1){
+		return -1;
+	}else if(n == 1 || n == 2){
+		return 1;
+	}else {
+		return recursive_fibonacci(n-1) + recursive_fibonacci(n-2);
+	}
+};
+
+constexpr long constexpr_fibonacci(int n){
+	return n < 1 ? -1:((n == 1 || n == 2)?1:constexpr_fibonacci(n-1)+constexpr_fibonacci(n-2));
+}
+
+}
+
+void check_fibonacci(){
+	const unsigned last = maxFibonacciIndex<uint128_t>();
+	uint128_t a = 0,b = 1;
+	for(unsigned n = 0; n <= last; n++){
+		uint128_t doubled = 0;
+		if(fibonacci(n) != a || !fibonacci_checked(n,doubled) || doubled != a){
+			throw std::runtime_error("F(" + std::to_string(n) + ") is wrong");
+		}
+		const uint128_t next = a + b;
+		a = b;
+		b = next;
+	}
+
+	bool overflowed = false;
+	try{
+		fibonacci(last + 1);
+	}catch(const std::overflow_error&){
+		overflowed = true;
+	}
+	uint64_t narrow = 0;
+	if(!overflowed || fibonacci_checked(fibonacciTableSize,narrow)){
+		throw std::runtime_error("fibonacci overflow is not detected");
+	}
+
+	//F(92) is the last value of a signed 64 bit type, F(93) of an unsigned one
+	bool signedOverflowed = false;
+	bool unsignedOverflowed = false;
+	try{
+		fibonacci_as<long long>(93);
+	}catch(const std::overflow_error&){
+		signedOverflowed = true;
+	}
+	try{
+		fibonacci_as<uint64_t>(94);
+	}catch(const std::overflow_error&){
+		unsignedOverflowed = true;
+	}
+	if(fibonacci_as<long long>(92) != 7540113804746346429LL ||
+		fibonacci_as<uint64_t>(93) != 12200160415121876738ULL ||
+		!signedOverflowed || !unsignedOverflowed){
+		throw std::runtime_error("fibonacci_as overflow is not detected at F(93)");
+	}
+	std::cout << "F(" << last << ") = " << to_string(fibonacci(last)) << std::endl;
+}
+
+void bench_fibonacci(unsigned n){
+	//volatile so the compiler can not fold the calls away
+	volatile unsigned index = n;
+	const size_t repeat = 1000000;
+
+	Stopwatch watch;
+	const long recursive = recursive_fibonacci(index);
+	const double recursiveTime = watch.seconds();
+
+	watch.reset();
+	const long constant = constexpr_fibonacci(index);
+	const double constantTime = watch.seconds();
+
+	watch.reset();
+	uint128_t engine = 0;
+	for(size_t i = 0; i < repeat; i++){
+		engine += fibonacci(index);
+	}
+	const double engineTime = watch.seconds() / repeat;
+
+	watch.reset();
+	uint128_t doubled = 0;
+	for(size_t i = 0; i < repeat; i++){
+		uint128_t value = 0;
+		fibonacci_checked(index + i % 2,value);
+		doubled += value;
+	}
+	const double doublingTime = watch.seconds() / repeat;
+
+	std::cout << "F(" << n << ") recursive std::function : " << recursiveTime * 1e9 << " ns" << std::endl;
+	std::cout << "F(" << n << ") recursive constexpr     : " << constantTime * 1e9 << " ns" << std::endl;
+	std::cout << "F(" << n << ") table lookup            : " << engineTime * 1e9 << " ns" << std::endl;
+	std::cout << "F(" << n << ") fast doubling           : " << doublingTime * 1e9 << " ns" << std::endl;
+	const uint128_t pairs = fibonacci(n) + fibonacci(n + 1);
+	std::cout << "results " << (uint128_t(recursive) * repeat == engine &&
+		recursive == constant && pairs * (repeat / 2) == doubled ? "match" : "DIFFER") << std::endl;
+}
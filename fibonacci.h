@@ -0,0 +1,155 @@
+#ifndef FIBONACCI_H
+#define FIBONACCI_H
+
+#include "bigHeader.h"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/*
+ 	fibonacci sequence engine
+
+ 	small n come from a table generated at compile time, larger n use
+ 	fast doubling in O(log n) steps
+ 		F(2k)   = F(k) * (2F(k+1) - F(k))
+ 		F(2k+1) = F(k)^2 + F(k+1)^2
+ 	every step is overflow checked, F(186) is the last value that fits in
+ 	128 bits
+*/
+using uint128_t = unsigned __int128;
+
+/**
+ * @brief      a + b and a * b into out, false when the result does not
+ *             fit in Number
+ */
+template<typename Number>
+constexpr bool checked_add(Number a,Number b,Number& out){
+	out = a + b;
+	return out >= a;
+}
+
+template<typename Number>
+constexpr bool checked_mul(Number a,Number b,Number& out){
+	out = a * b;
+	return a == 0 || out / a == b;
+}
+
+/**
+ * @brief      largest n whose F(n) still fits in Number
+ */
+template<typename Number>
+constexpr unsigned maxFibonacciIndex(){
+	Number a = 0,b = 1,next = 0;
+	unsigned n = 0;
+	while(checked_add(a,b,next)){
+		a = b;
+		b = next;
+		n++;
+	}
+	return n + 1;
+}
+
+template<typename Number,size_t N>
+constexpr std::array<Number,N> makeFibonacciTable(){
+	std::array<Number,N> table = {};
+	if(N > 1){
+		table[1] = 1;
+	}
+	for(size_t n = 2; n < N; n++){
+		table[n] = table[n - 1] + table[n - 2];
+	}
+	return table;
+}
+
+//every F(n) that fits in 64 bits, F(0) .. F(93)
+constexpr unsigned fibonacciTableSize = maxFibonacciIndex<uint64_t>() + 1;
+constexpr std::array<uint64_t,fibonacciTableSize> fibonacciTable =
+	makeFibonacciTable<uint64_t,fibonacciTableSize>();
+
+static_assert(fibonacciTable[10] == 55,"fibonacci table is wrong");
+static_assert(fibonacciTableSize == 94,"F(93) is the last 64 bit fibonacci number");
+static_assert(maxFibonacciIndex<uint128_t>() == 186,"F(186) is the last 128 bit fibonacci number");
+
+/**
+ * @brief      F(n) by fast doubling
+ *
+ * @return     false, leaving out untouched, when F(n) overflows Number
+ */
+template<typename Number>
+constexpr bool fibonacci_checked(unsigned n,Number& out){
+	//(a, b) = (F(k), F(k+1)) for k the leading bits of n
+	Number a = 0,b = 1;
+	int bit = 31;
+	while(bit >= 0 && !(n >> bit & 1)){
+		bit--;
+	}
+	for(; bit >= 0; bit--){
+		Number twiceB = 0,doubled = 0,even = 0,aa = 0,bb = 0,odd = 0;
+		if(!checked_add(b,b,twiceB) ||
+			!checked_mul(a,twiceB - a,even) ||
+			!checked_mul(a,a,aa)){
+			return false;
+		}
+		const bool last = bit == 0;
+		//on the last bit only F(n) is needed, F(n+1) may not fit
+		const bool oddNeeded = !last || (n & 1);
+		if(oddNeeded && (!checked_mul(b,b,bb) || !checked_add(aa,bb,odd))){
+			return false;
+		}
+		if(n >> bit & 1){
+			a = odd;
+			if(!last && !checked_add(even,odd,doubled)){
+				return false;
+			}
+			b = doubled;
+		}else{
+			a = even;
+			b = odd;
+		}
+	}
+	out = a;
+	return true;
+}
+
+/**
+ * @brief      F(n) for n up to 186, table lookup for the 64 bit range
+ *
+ * @throws     std::overflow_error when F(n) does not fit in 128 bits
+ */
+uint128_t fibonacci(unsigned n);
+
+/**
+ * @brief      F(n) as a Number of at most 64 bits, for the callers that
+ *             keep the signed return types of the old recursive versions
+ *
+ * @throws     std::overflow_error when F(n) does not fit in Number, e.g.
+ *             F(93) for a long
+ */
+template<typename Number>
+constexpr Number fibonacci_as(unsigned n){
+	static_assert(std::is_integral<Number>::value && sizeof(Number) <= sizeof(uint64_t),
+		"fibonacci_as is for the 64 bit table, use fibonacci for 128 bits");
+	if(n >= fibonacciTableSize ||
+		fibonacciTable[n] > static_cast<uint64_t>(std::numeric_limits<Number>::max())){
+		throw std::overflow_error("F(" + std::to_string(n) + ") does not fit in the result type");
+	}
+	return static_cast<Number>(fibonacciTable[n]);
+}
+
+/**
+ * @brief      decimal text of a 128 bit value, iostreams cannot print it
+ */
+std::string to_string(uint128_t value);
+
+/*
+ 	compares the engine with the table and a plain loop for every n
+*/
+void check_fibonacci();
+
+/*
+ 	recursive std::function lambda, recursive constexpr function and the
+ 	engine on the same n
+*/
+void bench_fibonacci(unsigned n = 30);
+
+#endif // FIBONACCI_H
@@ -0,0 +1,179 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 19:12:27
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 19:12:27
+*/
+
+#include "bigHeader.h"
+#include "template_alias.h"
+#include "stopwatch.h"
+
+#include <random>
+
+namespace{
+
+/*
+ 	n distinct keys of 13 to 16 characters, short enough to stay inline
+*/
+std::vector<std::string> make_keys(size_t n){
+	std::vector<std::string> keys;
+	keys.reserve(n);
+	for(size_t i = 0; i < n; i++){
+		//odd multiplier modulo 2^40 is a bijection, the keys stay distinct
+		keys.push_back("key" + std::to_string((i * 2654435761ULL) & ((1ULL << 40) - 1)));
+	}
+	return keys;
+}
+
+template<typename Map>
+size_t lookup_all(const Map& map,const std::vector<std::string>& keys,const std::vector<size_t>& order){
+	size_t sum = 0;
+	for(size_t i : order){
+		const auto found = map.find(keys[i]);
+		if(found != map.end()){
+			sum += found->second;
+		}
+	}
+	return sum;
+}
+
+void report(const char* backend,size_t n,double insert,double lookup,bool ok){
+	std::cout << "  " << backend << ": insert " << insert / n * 1e9 << " ns/key, lookup "
+		<< lookup / n * 1e9 << " ns/key" << (ok ? "" : " WRONG SUM") << std::endl;
+}
+
+template<typename Backend>
+void bench_backend(const char* backend,const std::vector<std::string>& keys,const std::vector<size_t>& order){
+	const size_t n = keys.size();
+	StrKeyMap<size_t,Backend> map;
+	Stopwatch watch;
+	for(size_t i = 0; i < n; i++){
+		map[keys[i]] = i;
+	}
+	const double insert = watch.seconds();
+
+	watch.reset();
+	const size_t sum = lookup_all(map,keys,order);
+	report(backend,n,insert,watch.seconds(),sum == n * (n - 1) / 2);
+}
+
+/*
+ 	a sorted vector is built in one go, inserting one key at a time
+ 	would be quadratic
+*/
+void bench_sorted(const std::vector<std::string>& keys,const std::vector<size_t>& order){
+	const size_t n = keys.size();
+	StrKeyMap<size_t,SortedBackend> map;
+	Stopwatch watch;
+	std::vector<std::pair<std::string_view,size_t>> pairs;
+	pairs.reserve(n);
+	for(size_t i = 0; i < n; i++){
+		pairs.emplace_back(keys[i],i);
+	}
+	map.assign(pairs.begin(),pairs.end());
+	const double insert = watch.seconds();
+
+	watch.reset();
+	const size_t sum = lookup_all(map,keys,order);
+	report("sorted (bulk)",n,insert,watch.seconds(),sum == n * (n - 1) / 2);
+}
+
+/*
+ 	throws when built from a multiple of 7, counts the live objects
+*/
+struct ThrowingValue{
+	static int live;
+
+	explicit ThrowingValue(int value):value(value){
+		if(value % 7 == 0){
+			throw std::runtime_error("ThrowingValue " + std::to_string(value));
+		}
+		live++;
+	}
+
+	ThrowingValue(ThrowingValue&& other) noexcept:value(other.value){
+		live++;
+	}
+
+	~ThrowingValue(){
+		live--;
+	}
+
+	int value;
+};
+
+int ThrowingValue::live = 0;
+
+}
+
+void check_flat_map(){
+	{
+		FlatStrKeyMap<ThrowingValue> map;
+		const std::vector<std::string> keys = make_keys(1000);
+		size_t inserted = 0,thrown = 0;
+		for(size_t i = 0; i < keys.size(); i++){
+			try{
+				map.emplace(keys[i],static_cast<int>(i));
+				inserted++;
+			}catch(const std::runtime_error&){
+				thrown++;
+			}
+		}
+		size_t visited = 0;
+		for(const auto& entry : map){
+			if(entry.second.value % 7 == 0){
+				throw std::runtime_error("flat map holds an entry that threw");
+			}
+			visited++;
+		}
+		if(map.size() != inserted || visited != inserted || ThrowingValue::live != static_cast<int>(inserted)
+			|| map.count(keys[7]) || !map.count(keys[8])){
+			throw std::runtime_error("flat map is inconsistent after a throwing emplace");
+		}
+		//the slot of a failed key can still be used
+		map.emplace(keys[7],8);
+		map.clear();
+		map.emplace(keys[14],15);
+		std::cout << "flat map: " << inserted << " inserted, " << thrown << " constructors threw" << std::endl;
+	}
+	if(ThrowingValue::live != 0){
+		throw std::runtime_error("flat map destroyed objects it never constructed");
+	}
+
+	//the 15th key grows a 16 slot table, the argument refers to an entry
+	//that the rehash moves
+	const std::string value(100,'v');
+	const std::vector<std::string> keys = make_keys(15);
+	auto filled = [&]{
+		FlatStrKeyMap<std::string> map;
+		for(size_t i = 0; i + 1 < keys.size(); i++){
+			map.emplace(keys[i],value);
+		}
+		return map;
+	};
+	FlatStrKeyMap<std::string> emplaced = filled();
+	emplaced.emplace(keys.back(),emplaced.at(keys.front()));
+	FlatStrKeyMap<std::string> assigned = filled();
+	assigned.insert_or_assign(keys.back(),assigned.at(keys.front()));
+	if(emplaced.at(keys.back()) != value || emplaced.at(keys.front()) != value
+		|| assigned.at(keys.back()) != value || assigned.at(keys.front()) != value){
+		throw std::runtime_error("flat map lost a value that referred into the table while growing");
+	}
+}
+
+void bench_str_key_map(const std::vector<size_t>& sizes){
+	for(size_t n : sizes){
+		const std::vector<std::string> keys = make_keys(n);
+		std::vector<size_t> order(n);
+		for(size_t i = 0; i < n; i++){
+			order[i] = i;
+		}
+		std::shuffle(order.begin(),order.end(),std::mt19937_64(n));
+
+		std::cout << n << " keys" << std::endl;
+		bench_backend<TreeBackend>("std::map     ",keys,order);
+		bench_backend<FlatBackend>("flat         ",keys,order);
+		bench_sorted(keys,order);
+	}
+}
@@ -0,0 +1,752 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include "bigHeader.h"
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ 	string key with the characters stored inline for short keys
+
+ 	up to 22 characters live in the 24 bytes of the key itself, so the
+ 	keys of a flat map are compared without following a pointer, longer
+ 	keys go to the heap
+*/
+class FlatKey{
+	public:
+		static constexpr size_t inlineCapacity = 22;
+
+		FlatKey(){
+			bytes[tagIndex] = 0;
+		}
+
+		FlatKey(std::string_view text){
+			assign(text);
+		}
+
+		FlatKey(const FlatKey& other){
+			assign(other.view());
+		}
+
+		FlatKey(FlatKey&& other) noexcept{
+			std::memcpy(bytes,other.bytes,sizeof(bytes));
+			other.bytes[tagIndex] = 0;
+		}
+
+		FlatKey& operator=(const FlatKey& other){
+			if(this != &other){
+				FlatKey copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		FlatKey& operator=(FlatKey&& other) noexcept{
+			if(this != &other){
+				destroy();
+				std::memcpy(bytes,other.bytes,sizeof(bytes));
+				other.bytes[tagIndex] = 0;
+			}
+			return *this;
+		}
+
+		~FlatKey(){
+			destroy();
+		}
+
+		std::string_view view() const{
+			if(onHeap()){
+				return std::string_view(heap().data,heap().size);
+			}
+			return std::string_view(bytes,static_cast<unsigned char>(bytes[tagIndex]));
+		}
+
+		operator std::string_view() const{
+			return view();
+		}
+
+		std::string str() const{
+			return std::string(view());
+		}
+
+		size_t size() const{
+			return view().size();
+		}
+
+		bool onHeap() const{
+			return static_cast<unsigned char>(bytes[tagIndex]) == heapTag;
+		}
+
+		friend bool operator==(const FlatKey& a,std::string_view b){
+			return a.view() == b;
+		}
+
+		friend bool operator<(const FlatKey& a,const FlatKey& b){
+			return a.view() < b.view();
+		}
+
+		friend std::ostream& operator<<(std::ostream& os,const FlatKey& key){
+			return os << key.view();
+		}
+
+	private:
+		static constexpr size_t tagIndex      = inlineCapacity + 1;
+		static constexpr unsigned char heapTag = 0xFF;
+
+		struct Heap{
+			char* data;
+			size_t size;
+		};
+
+		//inline characters, the last byte is the length or heapTag
+		char bytes[inlineCapacity + 2];
+
+		Heap heap() const{
+			Heap h;
+			std::memcpy(&h,bytes,sizeof(h));
+			return h;
+		}
+
+		void assign(std::string_view text){
+			if(text.size() <= inlineCapacity){
+				std::memcpy(bytes,text.data(),text.size());
+				bytes[tagIndex] = static_cast<char>(text.size());
+			}else{
+				Heap h{new char[text.size()],text.size()};
+				std::memcpy(h.data,text.data(),text.size());
+				std::memcpy(bytes,&h,sizeof(h));
+				bytes[tagIndex] = static_cast<char>(heapTag);
+			}
+		}
+
+		void destroy(){
+			if(onHeap()){
+				delete[] heap().data;
+				bytes[tagIndex] = 0;
+			}
+		}
+};
+
+/*
+ 	element of the flat maps, first and second like the pair of std::map
+*/
+template<typename T>
+struct FlatEntry{
+	FlatKey first;
+	T second;
+};
+
+/*
+ 	one group of 16 control bytes, matched 16 at a time with SSE2
+ 	a control byte is empty (-128), deleted (-2) or the 7 low hash bits
+ 	of the key stored in the slot
+*/
+class FlatControlGroup{
+	public:
+		static constexpr size_t width = 16;
+		static constexpr int8_t empty   = -128;
+		static constexpr int8_t deleted = -2;
+
+		explicit FlatControlGroup(const int8_t* control){
+#ifdef __SSE2__
+			bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+			std::memcpy(bytes,control,width);
+#endif
+		}
+
+		/**
+		 * @brief      bit i set when control byte i equals value
+		 */
+		uint32_t match(int8_t value) const{
+#ifdef __SSE2__
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value),bytes)));
+#else
+			uint32_t bits = 0;
+			for(size_t i = 0; i < width; i++){
+				bits |= static_cast<uint32_t>(bytes[i] == value) << i;
+			}
+			return bits;
+#endif
+		}
+
+		uint32_t matchEmpty() const{
+			return match(empty);
+		}
+
+		/**
+		 * @brief      free slots have the sign bit set, full ones do not
+		 */
+		uint32_t matchFree() const{
+#ifdef __SSE2__
+			return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+#else
+			uint32_t bits = 0;
+			for(size_t i = 0; i < width; i++){
+				bits |= static_cast<uint32_t>(bytes[i] < 0) << i;
+			}
+			return bits;
+#endif
+		}
+
+	private:
+#ifdef __SSE2__
+		__m128i bytes;
+#else
+		int8_t bytes[width];
+#endif
+};
+
+/*
+ 	open addressing hash map from strings to T in the SwissTable style
+
+ 	slots sit in groups of 16 with one control byte each, a lookup compares
+ 	the 7 bit hash tag of all 16 slots of a group in one SSE2 compare and
+ 	only looks at the keys whose tag matched, probing stops at the first
+ 	group that has an empty slot
+ 	keys are FlatKeys so short keys are compared in place
+
+ 	the interface follows the part of std::map that StrKeyMap users rely
+ 	on, iteration order is unspecified and inserting may move entries
+ 	unlike std::map, a reference or iterator from operator[], at, find or
+ 	emplace is invalidated by any later insert, so m["b"] = m["a"] reads a
+ 	moved entry when m["b"] grows the table, use insert_or_assign("b",
+ 	m.at("a")) instead, emplace and insert_or_assign take arguments that
+ 	refer into the map
+*/
+template<typename T>
+class FlatStrKeyMap{
+	public:
+		using key_type    = std::string;
+		using mapped_type = T;
+		using value_type  = FlatEntry<T>;
+		using size_type   = size_t;
+
+		template<bool Const>
+		class Iterator{
+			public:
+				using Entry = std::conditional_t<Const,const FlatEntry<T>,FlatEntry<T>>;
+				using iterator_category = std::forward_iterator_tag;
+				using value_type        = FlatEntry<T>;
+				using difference_type   = std::ptrdiff_t;
+				using pointer           = Entry*;
+				using reference         = Entry&;
+
+				Iterator() = default;
+
+				Iterator(const int8_t* control,Entry* entries,size_t index,size_t capacity)
+					:control(control),entries(entries),index(index),capacity(capacity){
+					skipFree();
+				}
+
+				//iterator to const_iterator
+				template<bool OtherConst,typename = std::enable_if_t<Const && !OtherConst>>
+				Iterator(const Iterator<OtherConst>& other)
+					:control(other.control),entries(other.entries),index(other.index),capacity(other.capacity){
+
+				}
+
+				reference operator*() const{
+					return entries[index];
+				}
+
+				pointer operator->() const{
+					return &entries[index];
+				}
+
+				Iterator& operator++(){
+					index++;
+					skipFree();
+					return *this;
+				}
+
+				Iterator operator++(int){
+					Iterator before = *this;
+					++*this;
+					return before;
+				}
+
+				bool operator==(const Iterator& other) const{
+					return index == other.index;
+				}
+
+				bool operator!=(const Iterator& other) const{
+					return index != other.index;
+				}
+
+			private:
+				template<bool>
+				friend class Iterator;
+
+				const int8_t* control = nullptr;
+				Entry* entries  = nullptr;
+				size_t index    = 0;
+				size_t capacity = 0;
+
+				void skipFree(){
+					while(index < capacity && control[index] < 0){
+						index++;
+					}
+				}
+		};
+
+		using iterator       = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		FlatStrKeyMap() = default;
+
+		FlatStrKeyMap(const FlatStrKeyMap& other){
+			reserve(other.size());
+			for(const FlatEntry<T>& entry : other){
+				emplace(entry.first.view(),entry.second);
+			}
+		}
+
+		FlatStrKeyMap(FlatStrKeyMap&& other) noexcept{
+			swap(other);
+		}
+
+		FlatStrKeyMap& operator=(FlatStrKeyMap other){
+			swap(other);
+			return *this;
+		}
+
+		~FlatStrKeyMap(){
+			clear();
+			deallocate();
+		}
+
+		void swap(FlatStrKeyMap& other) noexcept{
+			std::swap(control,other.control);
+			std::swap(entries,other.entries);
+			std::swap(capacity,other.capacity);
+			std::swap(_size,other._size);
+			std::swap(growthLeft,other.growthLeft);
+		}
+
+		/**
+		 * @brief      value of key, inserted value initialized when missing
+		 */
+		T& operator[](std::string_view key){
+			return emplace(key).first->second;
+		}
+
+		T& at(std::string_view key){
+			const size_t index = lookup(key);
+			if(index == npos){
+				throw std::out_of_range("FlatStrKeyMap::at: no key " + std::string(key));
+			}
+			return entries[index].second;
+		}
+
+		const T& at(std::string_view key) const{
+			return const_cast<FlatStrKeyMap*>(this)->at(key);
+		}
+
+		/**
+		 * @brief      inserts key with a T built from args unless key is
+		 *             already present
+		 *
+		 * @return     the entry of key and whether it was inserted
+		 */
+		template<typename... Args>
+		std::pair<iterator,bool> emplace(std::string_view key,Args&&... args){
+			const size_t hash  = hashOf(key);
+			const size_t found = lookup(key,hash);
+			if(found != npos){
+				return {iteratorAt(found),false};
+			}
+			if(growthLeft == 0){
+				//key and args may point into the table, build the entry
+				//before the rehash moves what they refer to
+				FlatEntry<T> entry{FlatKey(key),T(std::forward<Args>(args)...)};
+				const size_t index = claimSlot(hash);
+				::new(static_cast<void*>(&entries[index])) FlatEntry<T>(std::move(entry));
+				publishSlot(index,hash);
+				return {iteratorAt(index),true};
+			}
+			const size_t index = claimSlot(hash);
+			//the slot only counts as full once the entry is built, a key
+			//or a T that throws leaves the table as it was
+			::new(static_cast<void*>(&entries[index])) FlatEntry<T>{FlatKey(key),T(std::forward<Args>(args)...)};
+			publishSlot(index,hash);
+			return {iteratorAt(index),true};
+		}
+
+		template<typename Pair>
+		std::pair<iterator,bool> insert(Pair&& value){
+			return emplace(std::string_view(value.first),std::forward<Pair>(value).second);
+		}
+
+		template<typename Value>
+		std::pair<iterator,bool> insert_or_assign(std::string_view key,Value&& value){
+			auto result = emplace(key,std::forward<Value>(value));
+			if(!result.second){
+				result.first->second = std::forward<Value>(value);
+			}
+			return result;
+		}
+
+		iterator find(std::string_view key){
+			const size_t index = lookup(key);
+			return index == npos ? end() : iteratorAt(index);
+		}
+
+		const_iterator find(std::string_view key) const{
+			const size_t index = lookup(key);
+			return index == npos ? end() : const_iterator(control,entries,index,capacity);
+		}
+
+		size_t count(std::string_view key) const{
+			return lookup(key) != npos;
+		}
+
+		size_t erase(std::string_view key){
+			const size_t index = lookup(key);
+			if(index == npos){
+				return 0;
+			}
+			entries[index].~FlatEntry<T>();
+			control[index] = FlatControlGroup::deleted;
+			_size--;
+			return 1;
+		}
+
+		void clear(){
+			for(size_t i = 0; i < capacity; i++){
+				if(control[i] >= 0){
+					entries[i].~FlatEntry<T>();
+				}
+			}
+			if(capacity){
+				std::memset(control,FlatControlGroup::empty,capacity);
+			}
+			_size = 0;
+			growthLeft = maxLoad(capacity);
+		}
+
+		/**
+		 * @brief      room for n keys without rehashing
+		 */
+		void reserve(size_t n){
+			size_t wanted = FlatControlGroup::width;
+			while(maxLoad(wanted) < n){
+				wanted *= 2;
+			}
+			if(wanted > capacity){
+				rehash(wanted);
+			}
+		}
+
+		size_t size() const{
+			return _size;
+		}
+
+		bool empty() const{
+			return _size == 0;
+		}
+
+		iterator begin(){
+			return iterator(control,entries,0,capacity);
+		}
+
+		iterator end(){
+			return iterator(control,entries,capacity,capacity);
+		}
+
+		const_iterator begin() const{
+			return const_iterator(control,entries,0,capacity);
+		}
+
+		const_iterator end() const{
+			return const_iterator(control,entries,capacity,capacity);
+		}
+
+	private:
+		static constexpr size_t npos = size_t(-1);
+
+		int8_t* control     = nullptr;
+		FlatEntry<T>* entries = nullptr;
+		size_t capacity     = 0;
+		size_t _size        = 0;
+		size_t growthLeft   = 0;
+
+		static size_t hashOf(std::string_view key){
+			return std::hash<std::string_view>()(key);
+		}
+
+		//7/8 of the slots, probing stays short
+		static size_t maxLoad(size_t slots){
+			return slots - slots / 8;
+		}
+
+		static int8_t tagOf(size_t hash){
+			return static_cast<int8_t>(hash & 0x7F);
+		}
+
+		iterator iteratorAt(size_t index){
+			return iterator(control,entries,index,capacity);
+		}
+
+		size_t lookup(std::string_view key) const{
+			return lookup(key,hashOf(key));
+		}
+
+		/**
+		 * @brief      slot of key or npos, groups are visited in triangular
+		 *             order which reaches every group of a power of two table
+		 */
+		size_t lookup(std::string_view key,size_t hash) const{
+			if(!capacity){
+				return npos;
+			}
+			const size_t groupMask = capacity / FlatControlGroup::width - 1;
+			const int8_t tag = tagOf(hash);
+			size_t group = (hash >> 7) & groupMask;
+			for(size_t step = 1;; step++){
+				const size_t base = group * FlatControlGroup::width;
+				const FlatControlGroup bytes(control + base);
+				for(uint32_t bits = bytes.match(tag); bits; bits &= bits - 1){
+					const size_t index = base + __builtin_ctz(bits);
+					if(entries[index].first == key){
+						return index;
+					}
+				}
+				if(bytes.matchEmpty()){
+					return npos;
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		/**
+		 * @brief      first free slot for hash, grows the table when the
+		 *             load limit is reached, the slot stays free until
+		 *             publishSlot
+		 */
+		size_t claimSlot(size_t hash){
+			if(growthLeft == 0){
+				//many erased slots, clean up in place instead of growing
+				rehash(capacity && _size < capacity / 2 ? capacity : std::max<size_t>(capacity * 2,FlatControlGroup::width));
+			}
+			return freeSlot(hash);
+		}
+
+		/**
+		 * @brief      marks the slot full once its entry is constructed
+		 */
+		void publishSlot(size_t index,size_t hash){
+			if(control[index] == FlatControlGroup::empty){
+				growthLeft--;
+			}
+			control[index] = tagOf(hash);
+			_size++;
+		}
+
+		size_t freeSlot(size_t hash) const{
+			const size_t groupMask = capacity / FlatControlGroup::width - 1;
+			size_t group = (hash >> 7) & groupMask;
+			for(size_t step = 1;; step++){
+				const size_t base = group * FlatControlGroup::width;
+				const uint32_t bits = FlatControlGroup(control + base).matchFree();
+				if(bits){
+					return base + __builtin_ctz(bits);
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		void rehash(size_t slots){
+			int8_t* oldControl      = control;
+			FlatEntry<T>* oldEntries = entries;
+			const size_t oldCapacity = capacity;
+
+			control  = static_cast<int8_t*>(::operator new(slots));
+			entries  = static_cast<FlatEntry<T>*>(::operator new(slots * sizeof(FlatEntry<T>),std::align_val_t(alignof(FlatEntry<T>))));
+			capacity = slots;
+			std::memset(control,FlatControlGroup::empty,slots);
+			growthLeft = maxLoad(slots) - _size;
+
+			for(size_t i = 0; i < oldCapacity; i++){
+				if(oldControl[i] >= 0){
+					const size_t hash  = hashOf(oldEntries[i].first.view());
+					const size_t index = freeSlot(hash);
+					control[index] = tagOf(hash);
+					::new(static_cast<void*>(&entries[index])) FlatEntry<T>(std::move(oldEntries[i]));
+					oldEntries[i].~FlatEntry<T>();
+				}
+			}
+			if(oldCapacity){
+				::operator delete(oldControl);
+				::operator delete(oldEntries,std::align_val_t(alignof(FlatEntry<T>)));
+			}
+		}
+
+		void deallocate(){
+			if(capacity){
+				::operator delete(control);
+				::operator delete(entries,std::align_val_t(alignof(FlatEntry<T>)));
+				control  = nullptr;
+				entries  = nullptr;
+				capacity = 0;
+			}
+		}
+};
+
+/*
+ 	sorted vector of entries for read mostly tables
+
+ 	lookups are binary searches over contiguous FlatKeys, an insert moves
+ 	the entries behind it, so large tables should be built in one go with
+ 	assign()
+*/
+template<typename T>
+class SortedStrKeyMap{
+	public:
+		using key_type       = std::string;
+		using mapped_type    = T;
+		using value_type     = FlatEntry<T>;
+		using size_type      = size_t;
+		using iterator       = typename std::vector<FlatEntry<T>>::iterator;
+		using const_iterator = typename std::vector<FlatEntry<T>>::const_iterator;
+
+		/**
+		 * @brief      replaces the contents with the (key, value) pairs in
+		 *             [first, last), sorted once, the first of equal keys
+		 *             wins like repeated inserts would
+		 */
+		template<typename It>
+		void assign(It first,It last){
+			entries.clear();
+			for(; first != last; ++first){
+				entries.push_back(FlatEntry<T>{FlatKey(std::string_view(first->first)),first->second});
+			}
+			std::stable_sort(entries.begin(),entries.end(),
+				[](const FlatEntry<T>& a,const FlatEntry<T>& b){ return a.first < b.first; });
+			entries.erase(std::unique(entries.begin(),entries.end(),
+				[](const FlatEntry<T>& a,const FlatEntry<T>& b){ return a.first.view() == b.first.view(); }),
+				entries.end());
+		}
+
+		T& operator[](std::string_view key){
+			return emplace(key).first->second;
+		}
+
+		T& at(std::string_view key){
+			const iterator found = find(key);
+			if(found == end()){
+				throw std::out_of_range("SortedStrKeyMap::at: no key " + std::string(key));
+			}
+			return found->second;
+		}
+
+		const T& at(std::string_view key) const{
+			return const_cast<SortedStrKeyMap*>(this)->at(key);
+		}
+
+		template<typename... Args>
+		std::pair<iterator,bool> emplace(std::string_view key,Args&&... args){
+			const iterator position = lowerBound(key);
+			if(position != end() && position->first == key){
+				return {position,false};
+			}
+			return {entries.insert(position,FlatEntry<T>{FlatKey(key),T(std::forward<Args>(args)...)}),true};
+		}
+
+		template<typename Pair>
+		std::pair<iterator,bool> insert(Pair&& value){
+			return emplace(std::string_view(value.first),std::forward<Pair>(value).second);
+		}
+
+		template<typename Value>
+		std::pair<iterator,bool> insert_or_assign(std::string_view key,Value&& value){
+			auto result = emplace(key,std::forward<Value>(value));
+			if(!result.second){
+				result.first->second = std::forward<Value>(value);
+			}
+			return result;
+		}
+
+		iterator find(std::string_view key){
+			const iterator position = lowerBound(key);
+			return position != end() && position->first == key ? position : end();
+		}
+
+		const_iterator find(std::string_view key) const{
+			return const_cast<SortedStrKeyMap*>(this)->find(key);
+		}
+
+		size_t count(std::string_view key) const{
+			return find(key) != end();
+		}
+
+		size_t erase(std::string_view key){
+			const iterator found = find(key);
+			if(found == end()){
+				return 0;
+			}
+			entries.erase(found);
+			return 1;
+		}
+
+		void clear(){
+			entries.clear();
+		}
+
+		void reserve(size_t n){
+			entries.reserve(n);
+		}
+
+		size_t size() const{
+			return entries.size();
+		}
+
+		bool empty() const{
+			return entries.empty();
+		}
+
+		iterator begin(){
+			return entries.begin();
+		}
+
+		iterator end(){
+			return entries.end();
+		}
+
+		const_iterator begin() const{
+			return entries.begin();
+		}
+
+		const_iterator end() const{
+			return entries.end();
+		}
+
+	private:
+		std::vector<FlatEntry<T>> entries;
+
+		iterator lowerBound(std::string_view key){
+			return std::lower_bound(entries.begin(),entries.end(),key,
+				[](const FlatEntry<T>& entry,std::string_view key){ return entry.first.view() < key; });
+		}
+};
+
+/*
+ 	FlatStrKeyMap with a value type whose constructor throws, the table
+ 	has to stay consistent and destroy only what was constructed, and
+ 	emplace and insert_or_assign of an entry's own value while the table
+ 	grows
+*/
+void check_flat_map();
+
+/*
+ 	insert and lookup of n keys for every StrKeyMap backend
+*/
+void bench_str_key_map(const std::vector<size_t>& sizes = {1000,1000000,10000000});
+
+#endif // FLAT_MAP_H
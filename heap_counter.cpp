@@ -0,0 +1,102 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 18:31:09
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 18:31:09
+*/
+
+#include "heap_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace{
+
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> deallocations{0};
+std::atomic<size_t> bytes{0};
+
+/**
+ * @brief      the new_handler loop of the standard operator new, while
+ *             the heap is exhausted the installed handler may free memory
+ *             and the allocation is tried again, without one it is
+ *             std::bad_alloc
+ */
+template<typename Allocate>
+void* allocate_or_handle(Allocate allocate){
+	for(;;){
+		if(void* memory = allocate()){
+			return memory;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if(!handler){
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void* counted_malloc(size_t size){
+	allocations.fetch_add(1,std::memory_order_relaxed);
+	bytes.fetch_add(size,std::memory_order_relaxed);
+	return allocate_or_handle([size]{
+		return std::malloc(size ? size : 1);
+	});
+}
+
+void* counted_aligned_alloc(size_t size,std::align_val_t alignment){
+	allocations.fetch_add(1,std::memory_order_relaxed);
+	bytes.fetch_add(size,std::memory_order_relaxed);
+	//aligned_alloc wants the size to be a non zero multiple of the alignment
+	const size_t align   = static_cast<size_t>(alignment);
+	const size_t rounded = size ? (size + align - 1) / align * align : align;
+	return allocate_or_handle([align,rounded]{
+		return std::aligned_alloc(align,rounded);
+	});
+}
+
+void counted_free(void* memory){
+	if(memory){
+		deallocations.fetch_add(1,std::memory_order_relaxed);
+		std::free(memory);
+	}
+}
+
+}
+
+HeapCounters heapCounters(){
+	HeapCounters counters;
+	counters.allocations   = allocations.load(std::memory_order_relaxed);
+	counters.deallocations = deallocations.load(std::memory_order_relaxed);
+	counters.bytes         = bytes.load(std::memory_order_relaxed);
+	return counters;
+}
+
+/*
+ 	the array and nothrow forms of the standard library forward to these,
+ 	the sized deletes are replaced too so -Wsized-deallocation is quiet
+*/
+void* operator new(size_t size){
+	return counted_malloc(size);
+}
+
+void* operator new(size_t size,std::align_val_t alignment){
+	return counted_aligned_alloc(size,alignment);
+}
+
+void operator delete(void* memory) noexcept{
+	counted_free(memory);
+}
+
+void operator delete(void* memory,std::align_val_t) noexcept{
+	counted_free(memory);
+}
+
+void operator delete(void* memory,size_t) noexcept{
+	counted_free(memory);
+}
+
+void operator delete(void* memory,size_t,std::align_val_t) noexcept{
+	counted_free(memory);
+}
@@ -0,0 +1,30 @@
+#ifndef HEAP_COUNTER_H
+#define HEAP_COUNTER_H
+
+#include <cstddef>
+
+/*
+ 	counters of the global operator new / delete, heap_counter.cpp
+ 	replaces them for the whole program and counts every call
+*/
+struct HeapCounters{
+	size_t allocations   = 0;
+	size_t deallocations = 0;
+	size_t bytes         = 0; //requested by the allocations
+};
+
+/**
+ * @brief      totals since the program started, take two snapshots and
+ *             subtract them to see the traffic of a piece of code
+ */
+HeapCounters heapCounters();
+
+inline HeapCounters operator-(const HeapCounters& after,const HeapCounters& before){
+	HeapCounters delta;
+	delta.allocations   = after.allocations - before.allocations;
+	delta.deallocations = after.deallocations - before.deallocations;
+	delta.bytes         = after.bytes - before.bytes;
+	return delta;
+}
+
+#endif // HEAP_COUNTER_H
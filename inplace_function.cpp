@@ -0,0 +1,125 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 17:58:36
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 17:58:36
+*/
+
+#include "bigHeader.h"
+#include "inplace_function.h"
+#include "stopwatch.h"
+
+namespace{
+
+using MoveOnlyFunction = move_only_inplace_function<int(int)>;
+
+//the move only wrapper has no copy operations for traits to find
+static_assert(!std::is_copy_constructible<MoveOnlyFunction>::value,"move only inplace_function is copyable");
+static_assert(!std::is_copy_assignable<MoveOnlyFunction>::value,"move only inplace_function is copy assignable");
+static_assert(std::is_nothrow_move_constructible<MoveOnlyFunction>::value,"inplace_function move may throw");
+static_assert(std::is_copy_constructible<inplace_function<int(int)>>::value,"inplace_function is not copyable");
+static_assert(!std::is_nothrow_move_constructible<basic_inplace_function<int(int),32,true,false>>::value,
+	"inplace_function with NothrowMove false claims a noexcept move");
+
+int twice(int value){
+	return value * 2;
+}
+
+/*
+ 	a callable whose move may throw
+*/
+struct ThrowingMove{
+	ThrowingMove() = default;
+	ThrowingMove(const ThrowingMove&) = default;
+	ThrowingMove(ThrowingMove&&) noexcept(false){
+
+	}
+
+	int operator()(int value) const{
+		return value + 1;
+	}
+};
+
+/*
+ 	times calls constructions (each one destroyed again) and calls
+ 	invocations of one wrapper type built from make()
+*/
+template<typename Wrapper,typename Make>
+void bench_wrapper(const char* name,size_t calls,Make make){
+	volatile double input = 1.0;
+	size_t truths = 0;
+
+	Stopwatch watch;
+	for(size_t i = 0; i < calls; i++){
+		Wrapper wrapper = make();
+		truths += static_cast<bool>(wrapper);
+	}
+	const double construct = watch.seconds();
+
+	const Wrapper wrapper = make();
+	watch.reset();
+	for(size_t i = 0; i < calls; i++){
+		truths += wrapper(input);
+	}
+	const double invoke = watch.seconds();
+
+	std::cout << name << ": construct " << construct / calls * 1e9 << " ns, call "
+		<< invoke / calls * 1e9 << " ns (" << truths << ")" << std::endl;
+}
+
+template<typename Make>
+void bench_capture(const char* capture,size_t calls,Make make){
+	std::cout << capture << std::endl;
+	bench_wrapper<std::function<bool(double)>>("  std::function   ",calls,make);
+	bench_wrapper<inplace_function<bool(double),48>>("  inplace_function",calls,make);
+}
+
+}
+
+void check_inplace_function(){
+	int (*null)(int) = nullptr;
+	const inplace_function<int(int)> empty = null;
+	const inplace_function<int(int)> pointer = &twice;
+	if(empty || !pointer || pointer(21) != 42){
+		throw std::runtime_error("inplace_function from a function pointer is wrong");
+	}
+
+	std::vector<MoveOnlyFunction> owners;
+	owners.push_back([p = std::make_unique<int>(40)](int value){ return *p + value; });
+	owners.emplace_back(&twice);
+	owners.reserve(owners.capacity() + 1);
+	if(owners[0](2) != 42 || owners[1](21) != 42){
+		throw std::runtime_error("move only inplace_function lost its callable");
+	}
+
+	basic_inplace_function<int(int),32,true,false> throwing = ThrowingMove();
+	basic_inplace_function<int(int),32,true,false> moved = std::move(throwing);
+	if(throwing || moved(41) != 42){
+		throw std::runtime_error("inplace_function with a throwing move is wrong");
+	}
+	std::cout << "inplace_function check passed" << std::endl;
+}
+
+void bench_inplace_function(size_t calls){
+	//g(): the lambda only reads statics, nothing is captured
+	bench_capture("no capture, as in g()",calls,[]{
+		static auto a = 5;
+		static auto b = -3;
+		return [](double d){ return a + b + d > 0; };
+	});
+
+	//f(): two ints captured by value
+	bench_capture("two ints, as in f()",calls,[]{
+		auto a = 5;
+		auto b = -3;
+		return [a,b](double d){ return a + b + d > 0; };
+	});
+
+	//beyond the 16 bytes std::function keeps inline, it allocates
+	bench_capture("five doubles",calls,[]{
+		double w[5] = {1,2,3,4,5};
+		return [w0 = w[0],w1 = w[1],w2 = w[2],w3 = w[3],w4 = w[4]](double d){
+			return w0 + w1 + w2 + w3 + w4 + d > 0;
+		};
+	});
+}
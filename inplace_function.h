@@ -0,0 +1,191 @@
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include "bigHeader.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/*
+ 	std::function without the heap
+
+ 	the callable is always stored in Capacity bytes inside the object, a
+ 	callable that does not fit is a compile error instead of an allocation
+ 	one static table of function pointers per stored type does the call,
+ 	copy, move and destruction
+
+ 		inplace_function<bool(double)> f = [a,b](double d){ return d > a + b; };
+
+ 	Copyable false gives a move only wrapper that also accepts move only
+ 	callables (a lambda owning a unique_ptr), it has no copy operations at
+ 	all so traits and containers see it as move only
+ 	NothrowMove false accepts callables whose move may throw, the moves of
+ 	the wrapper are then not noexcept either
+*/
+template<typename Signature,size_t Capacity,bool Copyable,bool NothrowMove = true>
+class basic_inplace_function;
+
+template<typename Result,typename... Args,size_t Capacity,bool Copyable,bool NothrowMove>
+class basic_inplace_function<Result(Args...),Capacity,Copyable,NothrowMove>{
+	//for a move only wrapper the copy operations below take this private
+	//type, they are no copy operations then and the real ones are
+	//implicitly deleted because the move operations are declared
+	struct NotCopyable{};
+	using CopySource = std::conditional_t<Copyable,basic_inplace_function,NotCopyable>;
+
+	public:
+		static constexpr size_t capacity  = Capacity;
+		static constexpr size_t alignment = alignof(std::max_align_t);
+
+		basic_inplace_function() = default;
+
+		basic_inplace_function(std::nullptr_t){
+
+		}
+
+		template<typename Func,
+			typename Callable = std::decay_t<Func>,
+			typename = std::enable_if_t<!std::is_same<Callable,basic_inplace_function>::value>>
+		basic_inplace_function(Func&& func){
+			static_assert(sizeof(Callable) <= Capacity,
+				"callable does not fit in the inplace_function, raise Capacity");
+			static_assert(alignof(Callable) <= alignment,
+				"callable is over aligned for the inplace_function");
+			static_assert(!Copyable || std::is_copy_constructible<Callable>::value,
+				"a copyable inplace_function needs a copyable callable");
+			static_assert(std::is_invocable_r<Result,Callable&,Args...>::value,
+				"callable does not match the signature");
+			static_assert(!NothrowMove || std::is_nothrow_move_constructible<Callable>::value,
+				"callable may throw when moved, use an inplace_function with NothrowMove false");
+			//a null function pointer gives an empty wrapper, like std::function
+			if constexpr(std::is_pointer<std::remove_reference_t<Func>>::value){
+				if(func == nullptr){
+					return;
+				}
+			}
+			::new(static_cast<void*>(&storage)) Callable(std::forward<Func>(func));
+			operations = &operationsFor<Callable>;
+		}
+
+		basic_inplace_function(const CopySource& other){
+			if(other.operations){
+				other.operations->copy(&storage,&other.storage);
+				operations = other.operations;
+			}
+		}
+
+		basic_inplace_function(basic_inplace_function&& other) noexcept(NothrowMove){
+			if(other.operations){
+				other.operations->move(&storage,&other.storage);
+				operations = other.operations;
+				other.reset();
+			}
+		}
+
+		basic_inplace_function& operator=(const CopySource& other){
+			if(this != &other){
+				basic_inplace_function copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		basic_inplace_function& operator=(basic_inplace_function&& other) noexcept(NothrowMove){
+			if(this != &other){
+				reset();
+				if(other.operations){
+					other.operations->move(&storage,&other.storage);
+					operations = other.operations;
+					other.reset();
+				}
+			}
+			return *this;
+		}
+
+		~basic_inplace_function(){
+			reset();
+		}
+
+		/**
+		 * @brief      calls the stored callable
+		 *
+		 * @throws     std::bad_function_call when empty, like std::function
+		 */
+		Result operator()(Args... args) const{
+			if(!operations){
+				throw std::bad_function_call();
+			}
+			return operations->invoke(&storage,std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const{
+			return operations != nullptr;
+		}
+
+		void reset(){
+			if(operations){
+				operations->destroy(&storage);
+				operations = nullptr;
+			}
+		}
+
+	private:
+		using Storage = std::aligned_storage_t<Capacity,alignment>;
+
+		struct Operations{
+			Result (*invoke)(const Storage*,Args&&...);
+			void (*copy)(Storage*,const Storage*);
+			void (*move)(Storage*,Storage*);
+			void (*destroy)(Storage*);
+		};
+
+		template<typename Callable>
+		static Callable* as(const Storage* storage){
+			return std::launder(reinterpret_cast<Callable*>(const_cast<Storage*>(storage)));
+		}
+
+		template<typename Callable>
+		static void copyCallable(Storage* to,const Storage* from){
+			if constexpr(Copyable){
+				::new(static_cast<void*>(to)) Callable(*as<Callable>(from));
+			}
+		}
+
+		template<typename Callable>
+		static constexpr Operations operationsFor = {
+			[](const Storage* storage,Args&&... args)-> Result{
+				//callables are invoked non const, like std::function does
+				return (*as<Callable>(storage))(std::forward<Args>(args)...);
+			},
+			&copyCallable<Callable>,
+			[](Storage* to,Storage* from){
+				::new(static_cast<void*>(to)) Callable(std::move(*as<Callable>(from)));
+			},
+			[](Storage* storage){
+				as<Callable>(storage)->~Callable();
+			}
+		};
+
+		mutable Storage storage;
+		const Operations* operations = nullptr;
+};
+
+template<typename Signature,size_t Capacity = 32>
+using inplace_function = basic_inplace_function<Signature,Capacity,true>;
+
+template<typename Signature,size_t Capacity = 32>
+using move_only_inplace_function = basic_inplace_function<Signature,Capacity,false>;
+
+/*
+ 	copy and move traits of both wrappers and empty construction
+*/
+void check_inplace_function();
+
+/*
+ 	construction and call of std::function and inplace_function with the
+ 	captures of f() and g() in cpp_11.cpp, and one too big for the small
+ 	buffer of std::function
+*/
+void bench_inplace_function(size_t calls = 10000000);
+
+#endif // INPLACE_FUNCTION_H
@@ -0,0 +1,85 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 23:20:44
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 23:20:44
+*/
+
+#include "bigHeader.h"
+#include "layout.h"
+
+#include <cstddef>
+
+namespace{
+
+/*
+ 	a hot flight record in the order it was written
+*/
+struct DeclaredFlight{
+	char status;
+	double speed;
+	int engines;
+	char code;
+	double range;
+	short gate;
+};
+
+using FlightLayout = StructLayout<char,double,int,char,double,short>;
+using PackedFlight = PackedRecord<char,double,int,char,double,short>;
+
+//the computed layout is the one the compiler gives the struct
+static_assert(FlightLayout::size == sizeof(DeclaredFlight),"StructLayout size");
+static_assert(FlightLayout::alignment == alignof(DeclaredFlight),"StructLayout alignment");
+static_assert(FlightLayout::offsets[1] == offsetof(DeclaredFlight,speed),"StructLayout offset");
+static_assert(FlightLayout::offsets[3] == offsetof(DeclaredFlight,code),"StructLayout offset");
+static_assert(FlightLayout::offsets[5] == offsetof(DeclaredFlight,gate),"StructLayout offset");
+static_assert(sizeof(PackedFlight) == OptimizedLayout<char,double,int,char,double,short>::size,"PackedRecord size");
+static_assert(OptimizedLayout<char,double,int,char,double,short>::padding < alignof(double),"sorted members only pad the tail");
+
+template<typename... Ts>
+void report(const char* name){
+	using Declared  = StructLayout<Ts...>;
+	using Optimized = OptimizedLayout<Ts...>;
+	std::cout << name << ": payload " << Declared::payload
+		<< ", declared " << Declared::size << " (" << Declared::padding << " padding, "
+		<< Declared::perCacheLine << " per cache line)"
+		<< ", std::tuple " << TupleSize<Ts...>::value
+		<< ", reordered " << Optimized::size << " (" << Optimized::padding << " padding, "
+		<< Optimized::layout::perCacheLine << " per cache line)" << std::endl;
+}
+
+template<size_t I,typename Record>
+size_t real_offset(const Record& record){
+	return reinterpret_cast<const char*>(&get<I>(record)) - reinterpret_cast<const char*>(&record);
+}
+
+void expect(bool condition,const char* what){
+	if(!condition){
+		throw std::runtime_error(std::string("layout check failed: ") + what);
+	}
+}
+
+}
+
+void check_layout(){
+	report<char,double,int,char,double,short>("flight    ");
+	report<bool,std::string,int,bool,double>("plane     ");
+	report<char,long double,char,int,char,short>("telemetry ");
+
+	PackedFlight flight('a',945.0,4,'b',15700.0,short(12));
+	expect(get<0>(flight) == 'a' && get<1>(flight) == 945.0 && get<2>(flight) == 4,"read by declared index");
+	expect(get<3>(flight) == 'b' && get<4>(flight) == 15700.0 && get<5>(flight) == 12,"read by declared index");
+	get<1>(flight) = 950.0;
+	expect(flight.get<1>() == 950.0,"write by declared index");
+
+	expect(real_offset<0>(flight) == PackedFlight::offset<0>(),"offset of member 0");
+	expect(real_offset<1>(flight) == PackedFlight::offset<1>(),"offset of member 1");
+	expect(real_offset<2>(flight) == PackedFlight::offset<2>(),"offset of member 2");
+	expect(real_offset<3>(flight) == PackedFlight::offset<3>(),"offset of member 3");
+	expect(real_offset<4>(flight) == PackedFlight::offset<4>(),"offset of member 4");
+	expect(real_offset<5>(flight) == PackedFlight::offset<5>(),"offset of member 5");
+
+	PackedRecord<bool,std::string,int> named(true,"A380",4);
+	expect(get<1>(named) == "A380" && sizeof(named) == OptimizedLayout<bool,std::string,int>::size,"record with a string");
+	std::cout << "layout check passed" << std::endl;
+}
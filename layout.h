@@ -0,0 +1,239 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include "bigHeader.h"
+#include "type_list.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+/*
+ 	compile time layout of a member list
+
+ 	StructLayout<Ts...> is what a struct with members Ts... in that order
+ 	takes: the offset of every member, the size and alignment of the
+ 	whole and the bytes lost to padding
+ 	OptimizedLayout<Ts...> sorts the members by alignment, largest first,
+ 	which leaves no padding between members and at most alignment - 1
+ 	bytes at the end, PackedRecord<Ts...> is a record stored that way and
+ 	still addressed by the original member index
+
+ 		using Hot = PackedRecord<char,double,int,char,double,short>;
+ 		static_assert(sizeof(Hot) < StructLayout<char,double,int,char,double,short>::size,"");
+ 		Hot hot('a',945.0,4,'b',15700.0,12);
+ 		get<1>(hot) = 950.0;	//the double, wherever it was moved
+*/
+
+namespace layout_detail{
+
+constexpr size_t align_up(size_t offset,size_t alignment){
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+template<size_t N>
+constexpr std::array<size_t,N> struct_offsets(const std::array<size_t,N>& sizes,const std::array<size_t,N>& alignments){
+	std::array<size_t,N> offsets{};
+	size_t offset = 0;
+	for(size_t i = 0; i < N; i++){
+		offset = align_up(offset,alignments[i]);
+		offsets[i] = offset;
+		offset += sizes[i];
+	}
+	return offsets;
+}
+
+template<size_t N>
+constexpr size_t max_alignment(const std::array<size_t,N>& alignments){
+	size_t alignment = 1;
+	for(size_t i = 0; i < N; i++){
+		alignment = alignments[i] > alignment ? alignments[i] : alignment;
+	}
+	return alignment;
+}
+
+/**
+ * @brief      original indexes ordered by alignment, largest first, a
+ *             stable insertion sort so equal alignments keep their order
+ */
+template<size_t N>
+constexpr std::array<size_t,N> alignment_order(const std::array<size_t,N>& alignments){
+	std::array<size_t,N> order{};
+	for(size_t i = 0; i < N; i++){
+		order[i] = i;
+	}
+	for(size_t i = 1; i < N; i++){
+		const size_t current = order[i];
+		size_t j = i;
+		for(; j > 0 && alignments[order[j - 1]] < alignments[current]; j--){
+			order[j] = order[j - 1];
+		}
+		order[j] = current;
+	}
+	return order;
+}
+
+template<size_t N>
+constexpr std::array<size_t,N> invert(const std::array<size_t,N>& order){
+	std::array<size_t,N> position{};
+	for(size_t i = 0; i < N; i++){
+		position[order[i]] = i;
+	}
+	return position;
+}
+
+}
+
+template<typename... Ts>
+struct StructLayout{
+	static_assert(sizeof...(Ts) > 0,"StructLayout needs at least one member");
+
+	static constexpr size_t members = sizeof...(Ts);
+	static constexpr std::array<size_t,members> sizes{{sizeof(Ts)...}};
+	static constexpr std::array<size_t,members> alignments{{alignof(Ts)...}};
+	static constexpr std::array<size_t,members> offsets = layout_detail::struct_offsets(sizes,alignments);
+
+	static constexpr size_t alignment = layout_detail::max_alignment(alignments);
+	static constexpr size_t size      = layout_detail::align_up(offsets[members - 1] + sizes[members - 1],alignment);
+	static constexpr size_t payload   = TupleSize<Ts...>::payload;
+	static constexpr size_t padding   = size - payload;
+	//whole records in one 64 byte cache line
+	static constexpr size_t perCacheLine = 64 / size;
+};
+
+/*
+ 	members in the order they are stored, the last one alone so no empty
+ 	tail is left behind, sorted largest alignment first a nested member
+ 	adds no padding over a flat struct
+*/
+template<typename T,typename... Rest>
+struct PackedStorage{
+	template<typename Source,size_t I,size_t... Is>
+	PackedStorage(Source&& source,Indexes<I,Is...>)
+		:head(std::get<I>(std::forward<Source>(source))),tail(std::forward<Source>(source),Indexes<Is...>()){
+
+	}
+
+	PackedStorage() = default;
+
+	T head;
+	PackedStorage<Rest...> tail;
+};
+
+template<typename T>
+struct PackedStorage<T>{
+	template<typename Source,size_t I>
+	PackedStorage(Source&& source,Indexes<I>):head(std::get<I>(std::forward<Source>(source))){
+
+	}
+
+	PackedStorage() = default;
+
+	T head;
+};
+
+/**
+ * @brief      member K of the storage, K counts in stored order
+ */
+template<size_t K,typename Storage>
+auto& packed_member(Storage& storage){
+	if constexpr(K == 0){
+		return storage.head;
+	}else{
+		return packed_member<K - 1>(storage.tail);
+	}
+}
+
+template<typename... Ts>
+struct OptimizedLayout{
+	using Declared = StructLayout<Ts...>;
+
+	static constexpr size_t members = sizeof...(Ts);
+	//order[k] is the original index of the k-th stored member
+	static constexpr std::array<size_t,members> order = layout_detail::alignment_order(Declared::alignments);
+	//position[i] is where original member i is stored
+	static constexpr std::array<size_t,members> position = layout_detail::invert(order);
+
+	template<typename Stored>
+	struct Expand;
+
+	template<size_t... Ks>
+	struct Expand<Indexes<Ks...>>{
+		using layout  = StructLayout<std::tuple_element_t<order[Ks],std::tuple<Ts...>>...>;
+		using storage = PackedStorage<std::tuple_element_t<order[Ks],std::tuple<Ts...>>...>;
+		using source  = Indexes<order[Ks]...>;
+	};
+
+	using Stored = Expand<typename MakeIndexes<members>::type>;
+
+	//the members in stored order
+	using layout  = typename Stored::layout;
+	using storage = typename Stored::storage;
+
+	static constexpr size_t size    = layout::size;
+	static constexpr size_t padding = layout::padding;
+	//bytes saved against the declared order
+	static constexpr size_t saved   = Declared::size - layout::size;
+};
+
+/*
+ 	a record of Ts... stored in OptimizedLayout order, constructed and
+ 	read with the original member order
+*/
+template<typename... Ts>
+class PackedRecord{
+	public:
+		using Layout = OptimizedLayout<Ts...>;
+
+		PackedRecord() = default;
+
+		/**
+		 * @brief      members in declared order, each constructed in place
+		 */
+		explicit PackedRecord(Ts... values)
+			:storage(std::forward_as_tuple(std::move(values)...),typename Layout::Stored::source()){
+
+		}
+
+		/**
+		 * @brief      member I of the declared order
+		 */
+		template<size_t I>
+		auto& get(){
+			return packed_member<Layout::position[I]>(storage);
+		}
+
+		template<size_t I>
+		const auto& get() const{
+			return packed_member<Layout::position[I]>(storage);
+		}
+
+		/**
+		 * @brief      byte offset of member I of the declared order
+		 */
+		template<size_t I>
+		static constexpr size_t offset(){
+			return Layout::layout::offsets[Layout::position[I]];
+		}
+
+	private:
+		typename Layout::storage storage;
+};
+
+template<size_t I,typename... Ts>
+auto& get(PackedRecord<Ts...>& record){
+	return record.template get<I>();
+}
+
+template<size_t I,typename... Ts>
+const auto& get(const PackedRecord<Ts...>& record){
+	return record.template get<I>();
+}
+
+/*
+ 	layouts of the hot records before and after reordering, checked
+ 	against the compiler's own struct layout
+*/
+void check_layout();
+
+#endif // LAYOUT_H
@@ -0,0 +1,230 @@
+#ifndef LIFETIME_TRACKER_H
+#define LIFETIME_TRACKER_H
+
+#include "bigHeader.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <ostream>
+
+/*
+ 	snapshot of the special member calls of one type, take two and
+ 	subtract them to see what a piece of code did
+*/
+struct LifetimeCounts{
+	size_t constructions   = 0; //every constructor that is not a copy or a move
+	size_t copies          = 0;
+	size_t moves           = 0;
+	size_t copyAssignments = 0;
+	size_t moveAssignments = 0;
+	size_t destructions    = 0;
+	size_t allocations     = 0; //class operator new and TrackingAllocator
+	size_t bytes           = 0;
+
+	/**
+	 * @brief      objects constructed and not yet destroyed
+	 */
+	long alive() const{
+		return static_cast<long>(constructions + copies + moves) - static_cast<long>(destructions);
+	}
+};
+
+inline LifetimeCounts operator-(const LifetimeCounts& after,const LifetimeCounts& before){
+	LifetimeCounts delta;
+	delta.constructions   = after.constructions - before.constructions;
+	delta.copies          = after.copies - before.copies;
+	delta.moves           = after.moves - before.moves;
+	delta.copyAssignments = after.copyAssignments - before.copyAssignments;
+	delta.moveAssignments = after.moveAssignments - before.moveAssignments;
+	delta.destructions    = after.destructions - before.destructions;
+	delta.allocations     = after.allocations - before.allocations;
+	delta.bytes           = after.bytes - before.bytes;
+	return delta;
+}
+
+inline std::ostream& operator<<(std::ostream& out,const LifetimeCounts& counts){
+	return out << "constructions " << counts.constructions << ", copies " << counts.copies
+		<< ", moves " << counts.moves << ", copy assignments " << counts.copyAssignments
+		<< ", move assignments " << counts.moveAssignments << ", destructions " << counts.destructions
+		<< ", allocations " << counts.allocations << " (" << counts.bytes << " bytes)";
+}
+
+/*
+ 	the live counters of one type, relaxed atomics so tracked objects can
+ 	be made and destroyed on any thread
+*/
+struct LifetimeCounters{
+	std::atomic<size_t> constructions{0};
+	std::atomic<size_t> copies{0};
+	std::atomic<size_t> moves{0};
+	std::atomic<size_t> copyAssignments{0};
+	std::atomic<size_t> moveAssignments{0};
+	std::atomic<size_t> destructions{0};
+	std::atomic<size_t> allocations{0};
+	std::atomic<size_t> bytes{0};
+
+	LifetimeCounts snapshot() const{
+		LifetimeCounts counts;
+		counts.constructions   = constructions.load(std::memory_order_relaxed);
+		counts.copies          = copies.load(std::memory_order_relaxed);
+		counts.moves           = moves.load(std::memory_order_relaxed);
+		counts.copyAssignments = copyAssignments.load(std::memory_order_relaxed);
+		counts.moveAssignments = moveAssignments.load(std::memory_order_relaxed);
+		counts.destructions    = destructions.load(std::memory_order_relaxed);
+		counts.allocations     = allocations.load(std::memory_order_relaxed);
+		counts.bytes           = bytes.load(std::memory_order_relaxed);
+		return counts;
+	}
+
+	void allocated(size_t size){
+		allocations.fetch_add(1,std::memory_order_relaxed);
+		bytes.fetch_add(size,std::memory_order_relaxed);
+	}
+};
+
+/**
+ * @brief      the counters of T, one set per type for the whole program
+ */
+template<typename T>
+LifetimeCounters& lifetimeCounters(){
+	static LifetimeCounters counters;
+	return counters;
+}
+
+template<typename T>
+LifetimeCounts lifetimeCounts(){
+	return lifetimeCounters<T>().snapshot();
+}
+
+/*
+ 	CRTP mixin that counts the special member calls of Derived
+
+ 		class A : public LifetimeTracker<A>{ ... };
+ 		LifetimeCounts before = lifetimeCounts<A>();
+ 		vA.push_back(A());
+ 		LifetimeCounts delta = lifetimeCounts<A>() - before;
+
+ 	the compiler generated members of Derived call the ones here, a user
+ 	written copy or move constructor of Derived has to pass rhs on to the
+ 	tracker (A(A&& rhs):LifetimeTracker<A>(std::move(rhs))) or it is
+ 	counted as a plain construction
+ 	new Derived goes through the class operator new below and is counted
+ 	as an allocation of Derived
+*/
+template<typename Derived>
+class LifetimeTracker{
+	public:
+		static void* operator new(size_t size){
+			lifetimeCounters<Derived>().allocated(size);
+			return ::operator new(size);
+		}
+
+		static void* operator new[](size_t size){
+			lifetimeCounters<Derived>().allocated(size);
+			return ::operator new[](size);
+		}
+
+		static void operator delete(void* p) noexcept{
+			::operator delete(p);
+		}
+
+		static void operator delete[](void* p) noexcept{
+			::operator delete[](p);
+		}
+
+	protected:
+		LifetimeTracker() noexcept{
+			lifetimeCounters<Derived>().constructions.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		LifetimeTracker(const LifetimeTracker&) noexcept{
+			lifetimeCounters<Derived>().copies.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		LifetimeTracker(LifetimeTracker&&) noexcept{
+			lifetimeCounters<Derived>().moves.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		LifetimeTracker& operator=(const LifetimeTracker&) noexcept{
+			lifetimeCounters<Derived>().copyAssignments.fetch_add(1,std::memory_order_relaxed);
+			return *this;
+		}
+
+		LifetimeTracker& operator=(LifetimeTracker&&) noexcept{
+			lifetimeCounters<Derived>().moveAssignments.fetch_add(1,std::memory_order_relaxed);
+			return *this;
+		}
+
+		~LifetimeTracker(){
+			lifetimeCounters<Derived>().destructions.fetch_add(1,std::memory_order_relaxed);
+		}
+};
+
+/*
+ 	std::allocator that also counts its allocations as bytes of T, for
+ 	the memory a container spends on a tracked type
+
+ 		std::vector<A,TrackingAllocator<A>> vA;
+*/
+template<typename T>
+struct TrackingAllocator{
+	using value_type = T;
+
+	TrackingAllocator() = default;
+
+	template<typename U>
+	TrackingAllocator(const TrackingAllocator<U>&) noexcept{
+
+	}
+
+	T* allocate(size_t n){
+		lifetimeCounters<T>().allocated(n * sizeof(T));
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T* p,size_t n) noexcept{
+		std::allocator<T>().deallocate(p,n);
+	}
+
+	template<typename U>
+	bool operator==(const TrackingAllocator<U>&) const noexcept{
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const TrackingAllocator<U>&) const noexcept{
+		return false;
+	}
+};
+
+/*
+ 	what a piece of code is expected to do to a tracked type, only the
+ 	copy and move counts are checked since those are what regress when a
+ 	move silently becomes a copy
+*/
+struct ExpectedLifetime{
+	size_t copies;
+	size_t moves;
+};
+
+/**
+ * @brief      runs f and throws std::runtime_error naming the case when
+ *             the copies or moves of T differ from expected
+ *
+ * @return     everything f did to T
+ */
+template<typename T,typename Func>
+LifetimeCounts expect_lifetime(const char* name,ExpectedLifetime expected,Func f){
+	const LifetimeCounts before = lifetimeCounts<T>();
+	f();
+	const LifetimeCounts delta = lifetimeCounts<T>() - before;
+	if(delta.copies != expected.copies || delta.moves != expected.moves){
+		throw std::runtime_error(std::string(name) + ": expected " + std::to_string(expected.copies)
+			+ " copies and " + std::to_string(expected.moves) + " moves, got "
+			+ std::to_string(delta.copies) + " copies and " + std::to_string(delta.moves) + " moves");
+	}
+	return delta;
+}
+
+#endif // LIFETIME_TRACKER_H
@@ -0,0 +1,224 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 16:20:41
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 16:20:41
+*/
+
+#include "bigHeader.h"
+#include "logger.h"
+#include "stopwatch.h"
+
+#include <cstdio>
+
+const char* logLevelName(LogLevel level){
+	switch(level){
+		case LogLevel::Debug:   return "DEBUG";
+		case LogLevel::Info:    return "INFO";
+		case LogLevel::Warning: return "WARNING";
+		case LogLevel::Error:   return "ERROR";
+	}
+	return "?";
+}
+
+LogRegistry& LogRegistry::instance(){
+	static LogRegistry registry;
+	return registry;
+}
+
+void LogRegistry::add(const std::shared_ptr<LogStagingBuffer>& buffer){
+	std::lock_guard<std::mutex> lock(mutex);
+	buffers.push_back(buffer);
+}
+
+std::vector<std::shared_ptr<LogStagingBuffer>> LogRegistry::snapshot(){
+	std::lock_guard<std::mutex> lock(mutex);
+	//a thread that has exited will not log again, its ring goes once empty
+	buffers.erase(std::remove_if(buffers.begin(),buffers.end(),
+		[](const std::shared_ptr<LogStagingBuffer>& buffer){
+			return buffer->retired.load() && buffer->consumedUpTo() == buffer->producedUpTo();
+		}),buffers.end());
+	return buffers;
+}
+
+namespace{
+
+/*
+ 	owned by one thread, registers the ring on first use and retires it
+ 	when the thread exits, the registry keeps it alive until drained
+*/
+struct LogThreadBuffer{
+	std::shared_ptr<LogStagingBuffer> buffer = std::make_shared<LogStagingBuffer>();
+
+	LogThreadBuffer(){
+		LogRegistry::instance().add(buffer);
+	}
+
+	~LogThreadBuffer(){
+		buffer->retired = true;
+	}
+};
+
+}
+
+LogStagingBuffer& logStagingBuffer(){
+	thread_local LogThreadBuffer local;
+	return *local.buffer;
+}
+
+namespace{
+
+size_t count_lines(const char* path,const std::string& needle){
+	std::ifstream in(path);
+	std::string line;
+	size_t lines = 0;
+	while(std::getline(in,line)){
+		if(line.find(needle) != std::string::npos){
+			lines++;
+		}
+	}
+	return lines;
+}
+
+}
+
+void check_logger(){
+	int evaluated = 0;
+	uint64_t oversized = 0;
+	{
+		Logger<std::ofstream> logger(StreamPtr<std::ofstream>(new std::ofstream("logger_check.log")));
+
+		//a record over a quarter of the ring is dropped and counted
+		const uint64_t before = logger.dropped();
+		LOG_ERROR("oversized {}",std::string(LogStagingBuffer::capacity / 2,'x'));
+		oversized = logger.dropped() - before;
+
+		//below LOG_MIN_LEVEL the arguments are never evaluated
+		LOG_DEBUG("debug {}",++evaluated);
+		LOG_INFO("info {} of {} from {}",1,2.5,"main");
+		LOG_WARNING("no arguments");
+		LOG_ERROR("error {} {}",std::string("string"),std::string_view("view"));
+
+		std::vector<std::thread> threads;
+		for(int t = 0; t < 4; t++){
+			threads.emplace_back([t]{
+				for(int i = 0; i < 1000; i++){
+					LOG_INFO("thread {} record {}",t,i);
+				}
+			});
+		}
+		for(std::thread& thread : threads){
+			thread.join();
+		}
+		logger.flush();
+	}
+
+	const size_t threadRecords = count_lines("logger_check.log"," record ");
+	const bool formatted = count_lines("logger_check.log","INFO") > 0 &&
+		count_lines("logger_check.log","info 1 of 2.5 from main") == 1 &&
+		count_lines("logger_check.log","error string view") == 1;
+	const bool eliminated = minLogLevel > LogLevel::Debug ? evaluated == 0 : evaluated == 1;
+	const bool reported = oversized == 1 && count_lines("logger_check.log","1 records dropped") == 1 &&
+		count_lines("logger_check.log","oversized") == 0;
+	if(threadRecords != 4000 || !formatted || !eliminated || !reported){
+		throw std::runtime_error("logger check failed");
+	}
+
+	//with no Logger running a full ring drops records instead of waiting
+	const size_t unattended = LogStagingBuffer::capacity / 16;
+	const uint64_t before = LogRegistry::instance().dropped();
+	std::thread([unattended]{
+		for(size_t i = 0; i < unattended; i++){
+			LOG_INFO("unattended {}",i);
+		}
+	}).join();
+	const uint64_t dropped = LogRegistry::instance().dropped() - before;
+	{
+		Logger<std::ofstream> logger(StreamPtr<std::ofstream>(new std::ofstream("logger_check.log")));
+		logger.flush();
+	}
+	const size_t kept = count_lines("logger_check.log","unattended ");
+	if(dropped == 0 || kept + dropped != unattended){
+		throw std::runtime_error("logger check failed on a full ring");
+	}
+	std::cout << "logger wrote " << threadRecords << " thread records, debug arguments evaluated "
+		<< evaluated << " times, " << dropped << " of " << unattended
+		<< " records dropped with no logger running" << std::endl;
+	std::remove("logger_check.log");
+}
+
+namespace{
+
+/*
+ 	runs callsPerThread calls of call on every thread and returns the
+ 	latency of each call in nanoseconds, all threads start together
+*/
+template<typename Call>
+std::vector<long long> measure(size_t threads,size_t callsPerThread,Call call){
+	std::vector<std::vector<long long>> latencies(threads,std::vector<long long>(callsPerThread));
+	std::atomic<size_t> ready{0};
+	std::vector<std::thread> workers;
+	for(size_t t = 0; t < threads; t++){
+		workers.emplace_back([&,t]{
+			ready++;
+			while(ready.load() < threads){
+				std::this_thread::yield();
+			}
+			Stopwatch watch;
+			for(size_t i = 0; i < callsPerThread; i++){
+				watch.reset();
+				call(t,i);
+				latencies[t][i] = watch.nanoseconds();
+			}
+		});
+	}
+	for(std::thread& worker : workers){
+		worker.join();
+	}
+	std::vector<long long> all;
+	all.reserve(threads * callsPerThread);
+	for(const auto& latency : latencies){
+		all.insert(all.end(),latency.begin(),latency.end());
+	}
+	std::sort(all.begin(),all.end());
+	return all;
+}
+
+void report(const char* name,const std::vector<long long>& sorted,double seconds){
+	auto percentile = [&](double p){
+		return sorted[std::min(sorted.size() - 1,static_cast<size_t>(p * sorted.size()))];
+	};
+	std::cout << name << ": p50 " << percentile(0.50) << " ns, p99 " << percentile(0.99)
+		<< " ns, p99.9 " << percentile(0.999) << " ns, total " << seconds << " s" << std::endl;
+}
+
+}
+
+void bench_logger(size_t threads,size_t callsPerThread){
+	const std::string path = "logger_bench.log";
+
+	Stopwatch watch;
+	std::vector<long long> mutexLatency;
+	{
+		std::ofstream out(path);
+		std::mutex mutex;
+		mutexLatency = measure(threads,callsPerThread,[&](size_t t,size_t i){
+			std::lock_guard<std::mutex> lock(mutex);
+			out << "thread " << t << " record " << i << " value " << i * 0.5 << '\n';
+		});
+	}
+	report("mutex + ofstream",mutexLatency,watch.seconds());
+
+	watch.reset();
+	std::vector<long long> loggerLatency;
+	{
+		Logger<std::ofstream> logger(StreamPtr<std::ofstream>(new std::ofstream(path)));
+		loggerLatency = measure(threads,callsPerThread,[](size_t t,size_t i){
+			LOG_INFO("thread {} record {} value {}",t,i,i * 0.5);
+		});
+		logger.flush();
+	}
+	report("Logger          ",loggerLatency,watch.seconds());
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,464 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "bigHeader.h"
+#include "csv_printer.h"
+#include "template_alias.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/*
+ 	low latency logger in the style of NanoLog
+
+ 	the calling thread only copies the arguments in binary form into its
+ 	own single producer single consumer ring, a background thread decodes
+ 	the records, formats them and writes them to a StreamPtr<Stream>
+
+ 		LOG_INFO("row {} of {} written", row, path);
+
+ 	levels below LOG_MIN_LEVEL are compiled out, their arguments are not
+ 	even evaluated
+*/
+enum class LogLevel : uint8_t{
+	Debug,
+	Info,
+	Warning,
+	Error
+};
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1 //Info
+#endif
+
+constexpr LogLevel minLogLevel = static_cast<LogLevel>(LOG_MIN_LEVEL);
+
+const char* logLevelName(LogLevel level);
+
+/*
+ 	static description of one log statement, one per call site
+*/
+struct LogSite{
+	LogLevel level;
+	const char* format;
+	const char* file;
+	int line;
+};
+
+/*
+ 	turns the binary arguments of one record back into text
+*/
+using LogDecoder = void(*)(const char* args,const char* format,RowBuffer& out);
+
+struct LogRecordHeader{
+	uint32_t size; //header and arguments, 0 marks the wrap to the ring start
+	uint32_t reserved;
+	const LogSite* site;
+	LogDecoder decode;
+	int64_t timestamp;
+};
+
+class LogStagingBuffer;
+
+/*
+ 	every thread that ever logged, the logger thread walks this list
+ 	it also counts the running loggers and the records that were dropped
+*/
+class LogRegistry{
+	public:
+		static LogRegistry& instance();
+
+		void add(const std::shared_ptr<LogStagingBuffer>& buffer);
+
+		/**
+		 * @brief      the live buffers, retired ones that have been drained
+		 *             are dropped from the list
+		 */
+		std::vector<std::shared_ptr<LogStagingBuffer>> snapshot();
+
+		void attach(){
+			consumers.fetch_add(1,std::memory_order_release);
+		}
+
+		void detach(){
+			consumers.fetch_sub(1,std::memory_order_release);
+		}
+
+		/**
+		 * @brief      true while a Logger is running and will free ring space
+		 */
+		bool draining() const{
+			return consumers.load(std::memory_order_acquire) > 0;
+		}
+
+		void drop(){
+			drops.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief      records dropped since the program started
+		 */
+		uint64_t dropped() const{
+			return drops.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::mutex mutex;
+		std::vector<std::shared_ptr<LogStagingBuffer>> buffers;
+		std::atomic<int> consumers{0};
+		std::atomic<uint64_t> drops{0};
+};
+
+/*
+ 	per thread byte ring, the owning thread is the only producer and the
+ 	logger thread the only consumer, records are 8 byte aligned and never
+ 	wrap around the end of the ring
+*/
+class LogStagingBuffer{
+	public:
+		static const size_t capacity = 1 << 20;
+
+		/**
+		 * @brief      room for one record of n bytes, waits (yielding) while
+		 *             a Logger is running and behind, n is a multiple of 8
+		 *
+		 * @return     nullptr when the ring is full and no Logger is running
+		 *             to empty it, the caller drops the record
+		 */
+		char* reserve(size_t n){
+			const size_t offset = writePosition & (capacity - 1);
+			const size_t toEnd  = capacity - offset;
+			const size_t needed = n + (toEnd < n ? toEnd : 0);
+			while(writePosition + needed - readPosition.load(std::memory_order_acquire) > capacity){
+				if(!LogRegistry::instance().draining()){
+					return nullptr;
+				}
+				std::this_thread::yield();
+			}
+			if(toEnd < n){
+				LogRecordHeader wrap = {};
+				std::memcpy(data + offset,&wrap,sizeof(wrap.size));
+				writePosition += toEnd;
+			}
+			return data + (writePosition & (capacity - 1));
+		}
+
+		/**
+		 * @brief      publishes the reserved record
+		 */
+		void commit(size_t n){
+			writePosition += n;
+			published.store(writePosition,std::memory_order_release);
+		}
+
+		/**
+		 * @brief      consumer side, calls f(header, args) for every
+		 *             published record
+		 *
+		 * @return     number of records consumed
+		 */
+		template<typename Func>
+		size_t consume(Func f){
+			const uint64_t end = published.load(std::memory_order_acquire);
+			uint64_t position  = readPosition.load(std::memory_order_relaxed);
+			size_t records = 0;
+			while(position < end){
+				const size_t offset = position & (capacity - 1);
+				LogRecordHeader header;
+				std::memcpy(&header.size,data + offset,sizeof(header.size));
+				if(header.size == 0){
+					position += capacity - offset;
+					continue;
+				}
+				std::memcpy(&header,data + offset,sizeof(header));
+				f(header,data + offset + sizeof(header));
+				position += header.size;
+				records++;
+			}
+			readPosition.store(position,std::memory_order_release);
+			return records;
+		}
+
+		uint64_t producedUpTo() const{
+			return published.load(std::memory_order_acquire);
+		}
+
+		uint64_t consumedUpTo() const{
+			return readPosition.load(std::memory_order_acquire);
+		}
+
+		std::atomic<bool> retired{false};
+
+	private:
+		alignas(64) uint64_t writePosition = 0;
+		alignas(64) std::atomic<uint64_t> published{0};
+		alignas(64) std::atomic<uint64_t> readPosition{0};
+		alignas(64) char data[capacity];
+};
+
+/**
+ * @brief      the calling thread's ring, created on its first log call
+ */
+LogStagingBuffer& logStagingBuffer();
+
+/*
+ 	binary encoding of the arguments, numbers are copied as they are and
+ 	strings as a uint32 length followed by the bytes
+*/
+template<typename T>
+struct IsLogString : std::integral_constant<bool,
+	std::is_same<T,const char*>::value || std::is_same<T,char*>::value ||
+	std::is_same<T,std::string>::value || std::is_same<T,std::string_view>::value>{};
+
+template<typename T>
+size_t logArgSize(const T& value){
+	using Arg = std::decay_t<T>;
+	static_assert(std::is_arithmetic<Arg>::value || IsLogString<Arg>::value,
+		"log arguments must be numbers or strings");
+	if constexpr(std::is_arithmetic<Arg>::value){
+		return sizeof(Arg);
+	}else{
+		return sizeof(uint32_t) + std::string_view(value).size();
+	}
+}
+
+template<typename T>
+char* logArgEncode(char* out,const T& value){
+	using Arg = std::decay_t<T>;
+	if constexpr(std::is_arithmetic<Arg>::value){
+		const Arg copy = value;
+		std::memcpy(out,&copy,sizeof(Arg));
+		return out + sizeof(Arg);
+	}else{
+		const std::string_view text(value);
+		const uint32_t length = static_cast<uint32_t>(text.size());
+		std::memcpy(out,&length,sizeof(length));
+		std::memcpy(out + sizeof(length),text.data(),length);
+		return out + sizeof(length) + length;
+	}
+}
+
+/**
+ * @brief      decodes one argument and writes the format text up to and
+ *             including its {} placeholder
+ */
+template<typename Arg>
+void logArgDecode(const char*& args,std::string_view& format,RowBuffer& out){
+	const size_t hole = format.find("{}");
+	out.append(format.substr(0,hole));
+	format = hole == std::string_view::npos ? std::string_view() : format.substr(hole + 2);
+	if constexpr(std::is_arithmetic<Arg>::value){
+		Arg value;
+		std::memcpy(&value,args,sizeof(Arg));
+		args += sizeof(Arg);
+		if(hole != std::string_view::npos){
+			out.appendCell(value);
+		}
+	}else{
+		uint32_t length;
+		std::memcpy(&length,args,sizeof(length));
+		if(hole != std::string_view::npos){
+			out.append(args + sizeof(length),length);
+		}
+		args += sizeof(length) + length;
+	}
+}
+
+template<typename... Args>
+void logDecode([[maybe_unused]] const char* args,const char* format,RowBuffer& out){
+	std::string_view rest(format);
+	(logArgDecode<Args>(args,rest,out),...);
+	out.append(rest);
+}
+
+/**
+ * @brief      the hot path, sizes the record, copies the arguments and
+ *             publishes it, no formatting and no allocation
+ *             a record over a quarter of the ring, or one that finds the
+ *             ring full with no Logger running, is dropped and counted in
+ *             LogRegistry::dropped()
+ */
+template<typename... Args>
+void logRecord(const LogSite& site,const Args&... args){
+	const size_t argsSize = (sizeof(LogRecordHeader) + ... + logArgSize(args));
+	const size_t size = (argsSize + 7) & ~size_t(7);
+	if(size > LogStagingBuffer::capacity / 4){
+		LogRegistry::instance().drop();
+		return;
+	}
+	LogStagingBuffer& buffer = logStagingBuffer();
+	char* out = buffer.reserve(size);
+	if(!out){
+		LogRegistry::instance().drop();
+		return;
+	}
+
+	LogRecordHeader header;
+	header.size      = static_cast<uint32_t>(size);
+	header.reserved  = 0;
+	header.site      = &site;
+	header.decode    = &logDecode<std::decay_t<Args>...>;
+	header.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+	std::memcpy(out,&header,sizeof(header));
+
+	char* cursor = out + sizeof(header);
+	((cursor = logArgEncode(cursor,args)),...);
+	(void)cursor;
+	buffer.commit(size);
+}
+
+#define LOG_AT(level,format,...) \
+	do{ \
+		if constexpr((level) >= minLogLevel){ \
+			static constexpr LogSite logSite{(level),(format),__FILE__,__LINE__}; \
+			logRecord(logSite,##__VA_ARGS__); \
+		} \
+	}while(0)
+
+#define LOG_DEBUG(format,...)   LOG_AT(LogLevel::Debug,format,##__VA_ARGS__)
+#define LOG_INFO(format,...)    LOG_AT(LogLevel::Info,format,##__VA_ARGS__)
+#define LOG_WARNING(format,...) LOG_AT(LogLevel::Warning,format,##__VA_ARGS__)
+#define LOG_ERROR(format,...)   LOG_AT(LogLevel::Error,format,##__VA_ARGS__)
+
+/*
+ 	background consumer, owns the sink through a StreamPtr so the stream
+ 	is closed by StreamDeleter once the logger is gone
+ 	only one logger should run at a time, it drains every thread's ring
+ 	records dropped by the producers are reported as a warning line in the
+ 	sink and through dropped()
+*/
+template<typename Stream>
+class Logger{
+	public:
+		explicit Logger(StreamPtr<Stream> sink)
+			:sink(std::move(sink)),consumer(&Logger::consumerLoop,this){
+			LogRegistry::instance().attach();
+		}
+
+		~Logger(){
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			consumer.join();
+			LogRegistry::instance().detach();
+		}
+
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+		/**
+		 * @brief      returns once every record logged before the call, by
+		 *             any thread, has been written to the sink
+		 */
+		void flush(){
+			std::vector<std::pair<std::shared_ptr<LogStagingBuffer>,uint64_t>> targets;
+			for(const auto& buffer : LogRegistry::instance().snapshot()){
+				targets.emplace_back(buffer,buffer->producedUpTo());
+			}
+			const uint64_t target = ++flushRequested;
+			std::unique_lock<std::mutex> lock(mutex);
+			passDone.wait(lock,[&]{
+				if(passes < target){
+					return false;
+				}
+				for(const auto& pending : targets){
+					if(pending.first->consumedUpTo() < pending.second){
+						return false;
+					}
+				}
+				return true;
+			});
+		}
+
+		/**
+		 * @brief      records dropped since the program started, too large
+		 *             or logged into a full ring while no Logger was running
+		 */
+		uint64_t dropped() const{
+			return LogRegistry::instance().dropped();
+		}
+
+	private:
+		StreamPtr<Stream> sink;
+		RowBuffer text{1 << 16};
+		uint64_t reportedDrops = LogRegistry::instance().dropped();
+		std::mutex mutex;
+		std::condition_variable passDone;
+		std::atomic<uint64_t> flushRequested{0};
+		uint64_t passes = 0;
+		bool stopping   = false;
+		std::thread consumer;
+
+		size_t drain(){
+			size_t records = 0;
+			for(const auto& buffer : LogRegistry::instance().snapshot()){
+				records += buffer->consume([this](const LogRecordHeader& header,const char* args){
+					format(header,args);
+				});
+			}
+			const uint64_t drops = LogRegistry::instance().dropped();
+			if(drops != reportedDrops){
+				text.append(std::string_view("WARNING logger: "));
+				text.appendNumber(drops - reportedDrops);
+				text.append(std::string_view(" records dropped\n"));
+				reportedDrops = drops;
+			}
+			if(text.size()){
+				text.flushTo(*sink);
+				sink->flush();
+			}
+			return records;
+		}
+
+		void format(const LogRecordHeader& header,const char* args){
+			text.appendNumber(header.timestamp);
+			text.append(' ');
+			text.append(std::string_view(logLevelName(header.site->level)));
+			text.append(' ');
+			text.append(std::string_view(header.site->file));
+			text.append(':');
+			text.appendNumber(header.site->line);
+			text.append(' ');
+			header.decode(args,header.site->format,text);
+			text.append('\n');
+		}
+
+		void consumerLoop(){
+			for(;;){
+				const uint64_t requested = flushRequested.load();
+				const size_t records = drain();
+				bool stop;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					passes = requested;
+					stop = stopping;
+				}
+				passDone.notify_all();
+				if(stop && records == 0){
+					return;
+				}
+				if(records == 0){
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+				}
+			}
+		}
+};
+
+/*
+ 	writes a few records, checks compile time elimination and round trip
+*/
+void check_logger();
+
+/*
+ 	p50/p99 latency of one log call with threads concurrent producers,
+ 	against formatting under a mutex straight into the ofstream
+*/
+void bench_logger(size_t threads = 16,size_t callsPerThread = 200000);
+
+#endif // LOGGER_H
@@ -8,6 +8,23 @@
 #include "class_init.h"
 #include "move_semantics.h"
 #include "perfect_forward.h"
+#include "csv_printer.h"
+#include "csv_reader.h"
+#include "csv_simd.h"
+#include "csv_columnar.h"
+#include "async_sink.h"
+#include "logger.h"
+#include "fibonacci.h"
+#include "inplace_function.h"
+#include "arena.h"
+#include "flat_map.h"
+#include "concurrent_map.h"
+#include "mpmc_queue.h"
+#include "thread_pool.h"
+#include "expr_vector.h"
+#include "soa_vector.h"
+#include "layout.h"
+#include "type_batched.h"
 
 int main(){
 	//check_var_temp();
@@ -15,6 +32,43 @@ int main(){
 	//check_class_init();
 	//check_move_semant();
 	check_perfect_forward();
+	//bench_csv_printer(10000000);
+	//bench_csv_parallel(10000000);
+	//check_csv_reader();
+	//bench_csv_reader(10000000);
+	//check_csv_simd();
+	//check_csv_columnar();
+	//bench_csv_columnar(10000000);
+	//bench_async_sink(10000000);
+	//check_logger();
+	//bench_logger(16,200000);
+	//check_fibonacci();
+	//bench_fibonacci(30);
+	//check_inplace_function();
+	//bench_inplace_function(10000000);
+	//bench_lambda_store(1 << 20,100);
+	//bench_pooled_planes(1000000);
+	//check_pooled_planes();
+	//check_arena();
+	//check_flat_map();
+	//bench_str_key_map({1000,1000000,10000000});
+	//check_str_key_lookup(1000000);
+	//bench_concurrent_map(32,200000);
+	//check_mpmc_queue(100000);
+	//bench_mpmc_queue(200000);
+	//check_thread_pool();
+	//bench_thread_pool(100000);
+	//check_move_counts();
+	//bench_move_counts(1000000);
+	//check_expr_vector();
+	//bench_expr_vector(1000000,100);
+	//check_soa_vector();
+	//bench_soa_vector(1000000,20);
+	//check_layout();
+	//check_cherry_pick();
+	//bench_cherry_pick(1000000);
+	//check_plane_batches();
+	//bench_plane_dispatch(1000000,20);
 	
 	return 0;
 }
@@ -0,0 +1,120 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "bigHeader.h"
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ 	read only memory mapping of a whole file or of one byte range of it,
+ 	the mapping is released when the object goes away
+*/
+class MappedFile{
+	public:
+		/**
+		 * @brief      maps the whole file
+		 *
+		 * @param[in]  path  The path
+		 */
+		explicit MappedFile(const std::string& path){
+			const int fd = openFile(path);
+			map(fd,path,0,fileSize(fd,path));
+			::madvise(_mapping,_mapped,MADV_SEQUENTIAL);
+		}
+
+		/**
+		 * @brief      maps only [offset, offset + length) of the file, the
+		 *             rest of the file is never touched
+		 *             throws std::runtime_error when the range goes past the
+		 *             end of the file, reading it would raise SIGBUS
+		 *
+		 * @param[in]  path    The path
+		 * @param[in]  offset  The offset
+		 * @param[in]  length  The length
+		 */
+		MappedFile(const std::string& path,size_t offset,size_t length){
+			map(openFile(path),path,offset,length);
+		}
+
+		~MappedFile(){
+			if(_mapping){
+				::munmap(_mapping,_mapped);
+			}
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& rhs)
+			:_mapping(rhs._mapping),_mapped(rhs._mapped),_data(rhs._data),_size(rhs._size){
+			rhs._mapping = nullptr;
+			rhs._data    = nullptr;
+			rhs._size    = 0;
+		}
+
+		const char* data() const{
+			return _data;
+		}
+
+		size_t size() const{
+			return _size;
+		}
+
+	private:
+		void* _mapping     = nullptr;
+		size_t _mapped     = 0;
+		const char* _data  = nullptr;
+		size_t _size       = 0;
+
+		static int openFile(const std::string& path){
+			const int fd = ::open(path.c_str(),O_RDONLY);
+			if(fd < 0){
+				throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+			}
+			return fd;
+		}
+
+		/**
+		 * @brief      size of the open file, fd is closed when it throws
+		 */
+		static size_t fileSize(int fd,const std::string& path){
+			struct stat info;
+			if(::fstat(fd,&info) != 0){
+				const int error = errno;
+				::close(fd);
+				throw std::runtime_error("cannot stat " + path + ": " + std::strerror(error));
+			}
+			return static_cast<size_t>(info.st_size);
+		}
+
+		void map(int fd,const std::string& path,size_t offset,size_t length){
+			const size_t size = fileSize(fd,path);
+			if(offset > size || length > size - offset){
+				::close(fd);
+				throw std::runtime_error("cannot map " + path + ": bytes " + std::to_string(offset) + " + "
+					+ std::to_string(length) + " are past its end at " + std::to_string(size));
+			}
+			//mmap offsets have to be page aligned
+			const size_t page  = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+			const size_t start = offset - offset % page;
+			_mapped = length + (offset - start);
+			if(length){
+				_mapping = ::mmap(nullptr,_mapped,PROT_READ,MAP_PRIVATE,fd,static_cast<off_t>(start));
+			}
+			const int error = errno;
+			::close(fd);
+			if(_mapping == MAP_FAILED){
+				_mapping = nullptr;
+				throw std::runtime_error("cannot map " + path + ": " + std::strerror(error));
+			}
+			_data = _mapping ? static_cast<const char*>(_mapping) + (offset - start) : nullptr;
+			_size = length;
+		}
+};
+
+#endif // MAPPED_FILE_H
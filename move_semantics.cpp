@@ -7,6 +7,8 @@
 
 #include "bigHeader.h"
 #include "move_semantics.h"
+#include "lifetime_tracker.h"
+#include "stopwatch.h"
 
 /*
  	Move semantics in c++11
@@ -37,40 +39,38 @@
 	string s;
 	s+"abc" // rvalue because string::operaetor+ returns string
  */
-class HighPlane{
+class HighPlane : public LifetimeTracker<HighPlane>{
 
 	
 };
 
 
 
-class A1{
+//the special members are counted by LifetimeTracker instead of printed
+class A1 : public LifetimeTracker<A1>{
 	public:
 		A1(){
-		std::cout <<"A default constructor called" <<std::endl;
 
 	}
 
-	A1(const A1& rhs){
-		std::cout <<"A Copy constructor called" <<std::endl;
+	A1(const A1& rhs):LifetimeTracker<A1>(rhs){
 
 	}
 };
 
-class A{
+class A : public LifetimeTracker<A>{
 public:
 	A(){
-		std::cout <<"A default constructor called" <<std::endl;
+
 	}
 
-	A(const A& rhs){
+	A(const A& rhs):LifetimeTracker<A>(rhs){
 		//copy constructor => lvalues and const rvalues are passwed to the copy constructor
-		std::cout <<"A Copy constructor called" <<std::endl;
 	}
 	
-	A(A&& rhs){
+	A(A&& rhs):LifetimeTracker<A>(std::move(rhs)){
 		//move constructor =>non const rvalues are passed here
-		std::cout <<"A move constructor called" <<std::endl;
+		//not noexcept, so vector copies A when it reallocates
 	}
 };
 
@@ -150,6 +150,8 @@ struct Aa{
 };
 
 
+//ExprVector in expr_vector.h takes this to vectors, a + b + c + d there
+//builds no temporaries at all and is evaluated in one fused loop
 class MyOperator{
 	private:
 		int count = 0;
@@ -190,46 +192,6 @@ struct Curious{
 	}
 };
 
-/*
- Making move only tupes for better peformance
-
-*/
-
-class MyMoveOnlyType{
-
-private:
-	int *p;
-public:
-	
-	MyMoveOnlyType():p(new int[10]){
-
-	}
-
-	~MyMoveOnlyType(){
-		delete p;
-	}
-	
-	MyMoveOnlyType(const MyMoveOnlyType& rhs) = delete;
-	MyMoveOnlyType& operator=(const MyMoveOnlyType& rhs) = delete;
-
-	//move constructor
-	MyMoveOnlyType(MyMoveOnlyType&& rhs){
-		*this = std::move(rhs);
-	}
-	//move assignment
-	MyMoveOnlyType& operator=( MyMoveOnlyType&& rhs){
-		if(this == &rhs){
-			return *this;
-		}
-
-		p = rhs.p;
-		rhs.p = nullptr;
-		return *this;
-	}
-
-
-};
-
 void check_move_semant(){
 	std::string adeeb_lvalue = "adeeb mohammed"; //string adeeb mohammed is rvalue
 	std::string adeeb_next_val = adeeb_lvalue + "good boy"; // adeeb_lvalue + " good boy" is rvalue because + operator returns a string
@@ -256,15 +218,19 @@ void check_move_semant(){
 
 	//speed variation in lvalue reference and rvalue reference
 	
+	const LifetimeCounts beforeA = lifetimeCounts<A>();
 	std::vector<A> vA;
 	vA.push_back(A());
-	std::cout <<"==>One A insertion ends"<<std::endl;
+	std::cout <<"==>One A insertion: "<< lifetimeCounts<A>() - beforeA <<std::endl;
 	vA.push_back(A());
+	std::cout <<"==>Two A insertions: "<< lifetimeCounts<A>() - beforeA <<std::endl;
 
+	const LifetimeCounts beforeA1 = lifetimeCounts<A1>();
 	std::vector<A1> vA1;
 	vA1.push_back(A1());
-	std::cout <<"==>One A1 insertion ends"<<std::endl;
+	std::cout <<"==>One A1 insertion: "<< lifetimeCounts<A1>() - beforeA1 <<std::endl;
 	vA1.push_back(A1());
+	std::cout <<"==>Two A1 insertions: "<< lifetimeCounts<A1>() - beforeA1 <<std::endl;
 
 	/*
 	 	compiler generated move semantics
@@ -348,3 +314,132 @@ void check_move_semant(){
 	d_value = std::move(a_value);
 
 }
+
+namespace{
+
+auto make_jet = []() -> HighPlane{
+	return HighPlane();
+};
+
+/*
+ 	a plane model with a heap allocated string, NoexceptMove picks whether
+ 	vector may move it when it reallocates
+*/
+template<bool NoexceptMove>
+class TrackedModel : public LifetimeTracker<TrackedModel<NoexceptMove>>{
+	using Tracker = LifetimeTracker<TrackedModel<NoexceptMove>>;
+
+	public:
+		TrackedModel():model(48,'m'){
+
+		}
+
+		TrackedModel(const TrackedModel& rhs):Tracker(rhs),model(rhs.model){
+
+		}
+
+		TrackedModel(TrackedModel&& rhs) noexcept(NoexceptMove)
+			:Tracker(std::move(rhs)),model(std::move(rhs.model)){
+
+		}
+
+		TrackedModel& operator=(const TrackedModel&) = default;
+		TrackedModel& operator=(TrackedModel&&) = default;
+
+	private:
+		std::string model;
+};
+
+/**
+ * @brief      leaves v without spare capacity, the next push_back has to
+ *             reallocate and relocate every element
+ */
+template<typename T>
+void fill_capacity(std::vector<T>& v){
+	v.shrink_to_fit();
+	if(v.capacity() != v.size()){
+		throw std::runtime_error("shrink_to_fit left spare capacity");
+	}
+}
+
+}
+
+void check_move_counts(){
+	std::vector<A> vA;
+	expect_lifetime<A>("push_back(A()) into an empty vector",{0,1},[&]{
+		vA.push_back(A());
+	});
+	fill_capacity(vA);
+	expect_lifetime<A>("push_back(A()) reallocating, A(A&&) is not noexcept",{1,1},[&]{
+		vA.push_back(A());
+	});
+	vA.reserve(vA.size() + 2);
+	expect_lifetime<A>("emplace_back() with room",{0,0},[&]{
+		vA.emplace_back();
+	});
+	expect_lifetime<A>("push_back(std::move(const A))",{1,0},[&]{
+		const A constA;
+		vA.push_back(std::move(constA));
+	});
+
+	std::vector<A1> vA1;
+	expect_lifetime<A1>("push_back(A1()), A1 has no move constructor",{1,0},[&]{
+		vA1.push_back(A1());
+	});
+
+	std::vector<HighPlane> planes;
+	planes.reserve(2);
+	expect_lifetime<HighPlane>("push_back of a const HighPlane return",{1,0},[&]{
+		planes.push_back(make_const_jet());
+	});
+	expect_lifetime<HighPlane>("push_back of a HighPlane return",{0,1},[&]{
+		planes.push_back(make_jet());
+	});
+
+	std::vector<TrackedModel<true>> fast(4);
+	std::vector<TrackedModel<false>> slow(4);
+	fill_capacity(fast);
+	fill_capacity(slow);
+	expect_lifetime<TrackedModel<true>>("reallocating 4 noexcept movable models",{0,5},[&]{
+		fast.push_back(TrackedModel<true>());
+	});
+	expect_lifetime<TrackedModel<false>>("reallocating 4 throwing movable models",{4,1},[&]{
+		slow.push_back(TrackedModel<false>());
+	});
+
+	const LifetimeCounts heap = expect_lifetime<A>("new A",{0,0},[]{
+		std::unique_ptr<A> a(new A());
+	});
+	if(heap.allocations != 1 || heap.bytes != sizeof(A) || heap.alive() != 0){
+		throw std::runtime_error("new A was not counted by the class operator new");
+	}
+
+	std::cout << "move counts as expected, A: " << lifetimeCounts<A>() << std::endl;
+}
+
+namespace{
+
+template<bool NoexceptMove>
+void bench_push_back(const char* name,size_t count){
+	using Model = TrackedModel<NoexceptMove>;
+	const LifetimeCounts before = lifetimeCounts<Model>();
+	Stopwatch watch;
+	{
+		std::vector<Model,TrackingAllocator<Model>> models;
+		for(size_t i = 0; i < count; i++){
+			models.push_back(Model());
+		}
+	}
+	const double seconds = watch.seconds();
+	const LifetimeCounts delta = lifetimeCounts<Model>() - before;
+	std::cout << name << ": " << seconds * 1e9 / count << " ns per push_back, "
+		<< delta.copies << " copies, " << delta.moves << " moves, "
+		<< delta.allocations << " vector allocations of " << delta.bytes << " bytes" << std::endl;
+}
+
+}
+
+void bench_move_counts(size_t count){
+	bench_push_back<true>("noexcept move ",count);
+	bench_push_back<false>("throwing move ",count);
+}
@@ -8,6 +8,69 @@
 #ifndef MOVE_SEMANTICS_H
 #define MOVE_SEMANTICS_H
 
+#include <cstddef>
+
+/*
+ Making move only tupes for better peformance
+
+ the buffer is owned by exactly one object at a time, it can be handed
+ between threads by move only, see MPMCQueue
+*/
+
+class MyMoveOnlyType{
+
+private:
+	int *p;
+public:
+	static constexpr size_t length = 10;
+	
+	MyMoveOnlyType():p(new int[length]()){
+
+	}
+
+	~MyMoveOnlyType(){
+		delete[] p;
+	}
+	
+	MyMoveOnlyType(const MyMoveOnlyType& rhs) = delete;
+	MyMoveOnlyType& operator=(const MyMoveOnlyType& rhs) = delete;
+
+	//move constructor
+	MyMoveOnlyType(MyMoveOnlyType&& rhs) noexcept:p(rhs.p){
+		rhs.p = nullptr;
+	}
+	//move assignment
+	MyMoveOnlyType& operator=( MyMoveOnlyType&& rhs) noexcept{
+		if(this == &rhs){
+			return *this;
+		}
+
+		//the old buffer would leak otherwise
+		delete[] p;
+		p = rhs.p;
+		rhs.p = nullptr;
+		return *this;
+	}
+
+	//nullptr once moved from
+	int* data() const{
+		return p;
+	}
+
+};
+
 void check_move_semant();
 
+/*
+ 	asserts the copies and moves of the move semantics types in vector
+ 	operations, throws when a move has turned into a copy
+*/
+void check_move_counts();
+
+/*
+ 	push_back of count models without reserve, a noexcept move constructor
+ 	against one vector has to copy on reallocation
+*/
+void bench_move_counts(size_t count = 1000000);
+
 #endif // MOVE_SEMANTICS_H
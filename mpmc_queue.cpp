@@ -0,0 +1,239 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 21:02:15
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 21:02:15
+*/
+
+#include "bigHeader.h"
+#include "mpmc_queue.h"
+#include "move_semantics.h"
+#include "stopwatch.h"
+
+#include <deque>
+#include <mutex>
+
+namespace{
+
+long long now_ns(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ 	a move only payload with the time it was pushed, what the latency
+ 	benchmark sends through the queues
+*/
+struct TimedBuffer{
+	MyMoveOnlyType buffer;
+	long long pushedAt = 0;
+};
+
+/*
+ 	the obvious bounded queue, a deque behind one mutex, same interface
+ 	as MPMCQueue so the benchmark can run both
+*/
+template<typename T>
+class LockedQueue{
+	public:
+		explicit LockedQueue(size_t capacity):limit(capacity){
+
+		}
+
+		bool try_push(T&& value){
+			std::lock_guard<std::mutex> lock(mutex);
+			if(values.size() == limit){
+				return false;
+			}
+			values.push_back(std::move(value));
+			return true;
+		}
+
+		bool try_pop(T& out){
+			std::lock_guard<std::mutex> lock(mutex);
+			if(values.empty()){
+				return false;
+			}
+			out = std::move(values.front());
+			values.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex mutex;
+		std::deque<T> values;
+		size_t limit;
+};
+
+/*
+ 	producers push itemsPerProducer buffers tagged (producer, sequence),
+ 	consumers pop until everything arrived, each consumer checks that the
+ 	sequence of every producer only grows and seen counts the deliveries
+*/
+void stress(size_t producers,size_t consumers,size_t capacity,size_t itemsPerProducer){
+	MPMCQueue<MyMoveOnlyType> queue(capacity);
+	const size_t total = producers * itemsPerProducer;
+	std::vector<std::atomic<unsigned>> seen(total);
+	std::atomic<size_t> consumed{0};
+	std::atomic<size_t> orderErrors{0};
+	std::atomic<size_t> movedFromErrors{0};
+	std::vector<std::thread> threads;
+
+	for(size_t p = 0; p < producers; p++){
+		threads.emplace_back([&,p]{
+			for(size_t i = 0; i < itemsPerProducer; i++){
+				MyMoveOnlyType item;
+				item.data()[0] = static_cast<int>(p);
+				item.data()[1] = static_cast<int>(i);
+				queue.push(std::move(item));
+				if(item.data() != nullptr){
+					movedFromErrors++;
+				}
+			}
+		});
+	}
+	for(size_t c = 0; c < consumers; c++){
+		threads.emplace_back([&]{
+			std::vector<int> last(producers,-1);
+			MyMoveOnlyType item;
+			while(consumed.load() < total){
+				if(!queue.try_pop(item)){
+					std::this_thread::yield();
+					continue;
+				}
+				consumed++;
+				const int producer = item.data()[0];
+				const int sequence = item.data()[1];
+				if(sequence <= last[producer]){
+					orderErrors++;
+				}
+				last[producer] = sequence;
+				seen[producer * itemsPerProducer + sequence]++;
+			}
+		});
+	}
+	for(std::thread& thread : threads){
+		thread.join();
+	}
+
+	size_t lost = 0;
+	size_t duplicated = 0;
+	for(const auto& count : seen){
+		lost += count.load() == 0;
+		duplicated += count.load() > 1;
+	}
+	std::cout << producers << "P" << consumers << "C capacity " << queue.capacity() << ": "
+		<< total << " items, lost " << lost << ", duplicated " << duplicated
+		<< ", out of order " << orderErrors.load() << std::endl;
+	if(lost || duplicated || orderErrors.load() || movedFromErrors.load() || queue.size_approx()){
+		throw std::runtime_error("mpmc queue check failed");
+	}
+}
+
+/*
+ 	producers move their prepared buffers in, consumers pop them and
+ 	record push to pop latency, returns items per second
+*/
+template<typename Queue>
+double run(const char* name,size_t producers,size_t consumers,size_t itemsPerProducer){
+	Queue queue(1024);
+	const size_t total = producers * itemsPerProducer;
+	//buffers are allocated up front, only the queue is timed
+	std::vector<std::vector<TimedBuffer>> prepared(producers);
+	for(auto& buffers : prepared){
+		buffers.resize(itemsPerProducer);
+	}
+	std::vector<std::vector<long long>> latencies(consumers);
+	for(auto& latency : latencies){
+		latency.reserve(total / consumers + 1);
+	}
+	std::atomic<size_t> ready{0};
+	std::atomic<size_t> consumed{0};
+	std::vector<std::thread> threads;
+	auto wait_start = [&]{
+		ready++;
+		while(ready.load() < producers + consumers){
+			std::this_thread::yield();
+		}
+	};
+
+	Stopwatch watch;
+	for(size_t p = 0; p < producers; p++){
+		threads.emplace_back([&,p]{
+			wait_start();
+			for(TimedBuffer& buffer : prepared[p]){
+				buffer.pushedAt = now_ns();
+				while(!queue.try_push(std::move(buffer))){
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for(size_t c = 0; c < consumers; c++){
+		threads.emplace_back([&,c]{
+			wait_start();
+			TimedBuffer buffer;
+			while(consumed.load(std::memory_order_relaxed) < total){
+				if(!queue.try_pop(buffer)){
+					std::this_thread::yield();
+					continue;
+				}
+				latencies[c].push_back(now_ns() - buffer.pushedAt);
+				consumed.fetch_add(1,std::memory_order_relaxed);
+			}
+		});
+	}
+	for(std::thread& thread : threads){
+		thread.join();
+	}
+	const double seconds = watch.seconds();
+
+	std::vector<long long> all;
+	all.reserve(total);
+	for(const auto& latency : latencies){
+		all.insert(all.end(),latency.begin(),latency.end());
+	}
+	std::sort(all.begin(),all.end());
+	auto percentile = [&](double p){
+		return all[std::min(all.size() - 1,static_cast<size_t>(p * all.size()))];
+	};
+	const double perSecond = total / seconds;
+	std::cout << "  " << name << ": " << perSecond / 1e6 << " M items/s, p50 " << percentile(0.50)
+		<< " ns, p99 " << percentile(0.99) << " ns" << std::endl;
+	return perSecond;
+}
+
+}
+
+void check_mpmc_queue(size_t itemsPerProducer){
+	//a tiny queue keeps producers wrapping around full slots
+	stress(1,1,2,itemsPerProducer);
+	stress(4,4,8,itemsPerProducer);
+	stress(8,2,64,itemsPerProducer);
+	stress(2,8,1024,itemsPerProducer);
+
+	//whatever is left in the queue is destroyed with it
+	MPMCQueue<MyMoveOnlyType> leftovers(4);
+	leftovers.push(MyMoveOnlyType());
+	leftovers.push(MyMoveOnlyType());
+	MyMoveOnlyType extra;
+	if(!leftovers.try_push(std::move(extra)) || !leftovers.try_push(MyMoveOnlyType())){
+		throw std::runtime_error("mpmc queue rejected a push below capacity");
+	}
+	MyMoveOnlyType overflow;
+	if(leftovers.try_push(std::move(overflow)) || overflow.data() == nullptr){
+		throw std::runtime_error("mpmc queue took a push above capacity");
+	}
+	leftovers.pop();
+	std::cout << "mpmc queue check passed" << std::endl;
+}
+
+void bench_mpmc_queue(size_t itemsPerProducer){
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	for(size_t threads : {1,4,16}){
+		std::cout << threads << "P" << threads << "C, " << itemsPerProducer << " items per producer" << std::endl;
+		const double lockFree = run<MPMCQueue<TimedBuffer>>("mpmc ring  ",threads,threads,itemsPerProducer);
+		const double locked = run<LockedQueue<TimedBuffer>>("mutex deque",threads,threads,itemsPerProducer);
+		std::cout << "  speedup " << lockFree / locked << "x" << std::endl;
+	}
+}
@@ -0,0 +1,200 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include "bigHeader.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+/*
+ 	bounded multi producer multi consumer queue (Dmitry Vyukov's ring)
+
+ 	every slot carries a sequence number that tells whose turn it is, a
+ 	producer claims a slot with one CAS on the enqueue position and
+ 	publishes it with a release store of the sequence, consumers do the
+ 	mirror image on the dequeue position, no locks anywhere
+ 	slots and the two positions sit on their own cache lines so producers
+ 	and consumers do not false share
+
+ 	values only ever go in and come out by move, T must be nothrow
+ 	movable so a half moved slot can not happen
+
+ 		MPMCQueue<MyMoveOnlyType> queue(1024);
+ 		queue.push(MyMoveOnlyType());
+ 		MyMoveOnlyType value = queue.pop();
+*/
+template<typename T>
+class MPMCQueue{
+	static_assert(std::is_nothrow_move_constructible<T>::value,"MPMCQueue: T must be nothrow move constructible");
+	static_assert(std::is_nothrow_move_assignable<T>::value,"MPMCQueue: T must be nothrow move assignable");
+
+	public:
+		static constexpr size_t cacheLine = 64;
+
+		/**
+		 * @brief      capacity is rounded up to a power of two, at least 2
+		 */
+		explicit MPMCQueue(size_t capacity){
+			size_t rounded = 2;
+			while(rounded < capacity){
+				rounded <<= 1;
+			}
+			mask = rounded - 1;
+			slots = new Slot[rounded];
+			for(size_t i = 0; i < rounded; i++){
+				slots[i].sequence.store(i,std::memory_order_relaxed);
+			}
+		}
+
+		~MPMCQueue(){
+			//destroy what nobody popped
+			size_t pos = dequeuePos.load(std::memory_order_relaxed);
+			const size_t end = enqueuePos.load(std::memory_order_relaxed);
+			for(; pos != end; pos++){
+				slots[pos & mask].value()->~T();
+			}
+			delete[] slots;
+		}
+
+		MPMCQueue(const MPMCQueue&) = delete;
+		MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+		/**
+		 * @brief      moves value in, value is untouched when the queue is full
+		 *
+		 * @return     false when the queue is full
+		 */
+		bool try_push(T&& value){
+			Slot* slot;
+			size_t pos = enqueuePos.load(std::memory_order_relaxed);
+			for(;;){
+				slot = &slots[pos & mask];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+				if(diff == 0){
+					if(enqueuePos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed)){
+						break;
+					}
+				}else if(diff < 0){
+					return false;
+				}else{
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+			new (&slot->storage) T(std::move(value));
+			slot->sequence.store(pos + 1,std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief      moves the oldest value into out
+		 *
+		 * @return     false when the queue is empty, out is untouched then
+		 */
+		bool try_pop(T& out){
+			return consume([&out](T&& value){
+				out = std::move(value);
+			});
+		}
+
+		/**
+		 * @brief      try_push until it succeeds, yields while full
+		 */
+		void push(T&& value){
+			while(!try_push(std::move(value))){
+				std::this_thread::yield();
+			}
+		}
+
+		/**
+		 * @brief      try_pop until it succeeds, yields while empty
+		 */
+		T pop(){
+			std::optional<T> value;
+			auto take = [&value](T&& popped){
+				value.emplace(std::move(popped));
+			};
+			while(!consume(take)){
+				std::this_thread::yield();
+			}
+			return std::move(*value);
+		}
+
+		size_t capacity() const{
+			return mask + 1;
+		}
+
+		/**
+		 * @brief      number of values at some recent moment, exact only
+		 *             while no thread pushes or pops
+		 */
+		size_t size_approx() const{
+			const size_t end = enqueuePos.load(std::memory_order_relaxed);
+			const size_t begin = dequeuePos.load(std::memory_order_relaxed);
+			return end > begin ? end - begin : 0;
+		}
+
+	private:
+		struct alignas(cacheLine) Slot{
+			std::atomic<size_t> sequence;
+			typename std::aligned_storage<sizeof(T),alignof(T)>::type storage;
+
+			T* value(){
+				return std::launder(reinterpret_cast<T*>(&storage));
+			}
+		};
+
+		Slot* slots;
+		size_t mask;
+		alignas(cacheLine) std::atomic<size_t> enqueuePos{0};
+		alignas(cacheLine) std::atomic<size_t> dequeuePos{0};
+
+		/**
+		 * @brief      claims the oldest slot and hands its value to f as an
+		 *             rvalue, pop never default constructs a T this way
+		 */
+		template<typename Func>
+		bool consume(Func f){
+			Slot* slot;
+			size_t pos = dequeuePos.load(std::memory_order_relaxed);
+			for(;;){
+				slot = &slots[pos & mask];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+				if(diff == 0){
+					if(dequeuePos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed)){
+						break;
+					}
+				}else if(diff < 0){
+					return false;
+				}else{
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+			T* value = slot->value();
+			f(std::move(*value));
+			value->~T();
+			//the slot is free again one lap later
+			slot->sequence.store(pos + mask + 1,std::memory_order_release);
+			return true;
+		}
+};
+
+/*
+ 	stress test, producers push distinct numbered MyMoveOnlyType buffers
+ 	and consumers check every one arrives exactly once and in order per
+ 	producer, build with make tsan to run it under ThreadSanitizer
+*/
+void check_mpmc_queue(size_t itemsPerProducer = 100000);
+
+/*
+ 	items per second and p50/p99 push to pop latency for 1P1C, 4P4C and
+ 	16P16C on a 1024 slot queue
+*/
+void bench_mpmc_queue(size_t itemsPerProducer = 200000);
+
+#endif // MPMC_QUEUE_H
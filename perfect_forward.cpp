@@ -7,6 +7,7 @@
 
 #include "bigHeader.h"
 #include "perfect_forward.h"
+#include "fibonacci.h"
 
 /*
  	perfect forwarding problem is solved this way
@@ -15,11 +16,15 @@
 template<typename T,typename T1, typename T2>
 std::unique_ptr<T> make_unique(T1&& arg1,T2&& arg2){
 	return std::unique_ptr<T>(new T(
-		std::forward<T>(arg1),
-		std::forward<T>(arg2)
+		std::forward<T1>(arg1),
+		std::forward<T2>(arg2)
 		));
 }
 
+/*
+ 	variadic version, make_pooled in pool.h is the same with the memory
+ 	coming from a per thread free list instead of new
+*/
 template<typename T,typename... Args>
 std::unique_ptr<T> make_unique(Args&&... args){
 	return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
@@ -40,12 +45,17 @@ std::unique_ptr<T> make_unique(Args&&... args){
 
 /*
  	constant expression
+ 	table lookup instead of the exponential recursion, the table itself is
+ 	generated at compile time in fibonacci.h
  */
 
 constexpr long fibonacci(int n){
-	return n < 1 ? -1:((n == 1 || n == 2)?1:fibonacci(n-1)+fibonacci(n-2));
+	return n < 1 ? -1 : fibonacci_as<long>(n);
 }
 
+static_assert(fibonacci(50) == 12586269025,"constexpr fibonacci is wrong");
+static_assert(fibonacci(92) == 7540113804746346429,"F(92) is the last fibonacci number in a long");
+
 
 void check_perfect_forward(){
 	auto a = 10;
@@ -0,0 +1,177 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "bigHeader.h"
+#include "arena.h"
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+/*
+ 	per type, per thread free list of T sized slots
+
+ 	slots are carved from chunks of slotsPerChunk objects, a freed slot goes
+ 	on the free list of the thread that frees it and is handed out again
+ 	by the next allocate on that thread
+ 	chunks are kept for the life of the process, an object may outlive the
+ 	thread that allocated it or be freed on another thread
+
+ 	freeing on another thread moves the slot to that thread's list, with
+ 	one thread allocating and another freeing the slots pile up on the
+ 	freeing thread and the allocating one keeps carving new chunks
+ 	a thread that exits hands its free list to a process wide list, the
+ 	next thread that runs dry takes all of it before carving a new chunk
+*/
+template<typename T>
+class FreeListPool{
+	public:
+		static const size_t slotsPerChunk = 256;
+
+		static FreeListPool& local(){
+			thread_local FreeListPool pool;
+			return pool;
+		}
+
+		FreeListPool(const FreeListPool&) = delete;
+		FreeListPool& operator=(const FreeListPool&) = delete;
+
+		/**
+		 * @brief      the thread exits, its free slots go to the process
+		 *             wide list instead of being lost
+		 */
+		~FreeListPool(){
+			if(!freeList){
+				return;
+			}
+			Slot* last = freeList;
+			while(last->next){
+				last = last->next;
+			}
+			Orphans& orphans = orphaned();
+			std::lock_guard<std::mutex> lock(orphans.mutex);
+			last->next = orphans.freeList;
+			orphans.freeList = freeList;
+			freeList = nullptr;
+		}
+
+		void* allocate(){
+			if(!freeList){
+				refill();
+			}
+			Slot* slot = freeList;
+			freeList = slot->next;
+			return slot;
+		}
+
+		void deallocate(void* memory){
+			Slot* slot = static_cast<Slot*>(memory);
+			slot->next = freeList;
+			freeList = slot;
+		}
+
+		/**
+		 * @brief      chunks this thread took from the heap
+		 */
+		size_t chunksAllocated() const{
+			return chunks;
+		}
+
+	private:
+		union Slot{
+			Slot* next;
+			alignas(T) unsigned char object[sizeof(T)];
+		};
+
+		/*
+		 	free slots left behind by threads that have exited
+		*/
+		struct Orphans{
+			std::mutex mutex;
+			Slot* freeList = nullptr;
+		};
+
+		Slot* freeList = nullptr;
+		size_t chunks  = 0;
+
+		FreeListPool(){
+			//constructed first so it is destroyed after every pool
+			orphaned();
+		}
+
+		static Orphans& orphaned(){
+			static Orphans orphans;
+			return orphans;
+		}
+
+		void refill(){
+			{
+				Orphans& orphans = orphaned();
+				std::lock_guard<std::mutex> lock(orphans.mutex);
+				if(orphans.freeList){
+					freeList = orphans.freeList;
+					orphans.freeList = nullptr;
+					return;
+				}
+			}
+			Slot* chunk = static_cast<Slot*>(::operator new(sizeof(Slot) * slotsPerChunk,std::align_val_t(alignof(Slot))));
+			for(size_t i = slotsPerChunk; i-- > 0;){
+				chunk[i].next = freeList;
+				freeList = &chunk[i];
+			}
+			chunks++;
+		}
+};
+
+/*
+ 	deleters for the pointers make_pooled and make_arena return
+*/
+template<typename T>
+struct PoolDeleter{
+	void operator()(T* object) const{
+		object->~T();
+		FreeListPool<T>::local().deallocate(object);
+	}
+};
+
+/*
+ 	only runs the destructor, the memory goes back with the arena
+*/
+template<typename T>
+struct ArenaDeleter{
+	void operator()(T* object) const{
+		object->~T();
+	}
+};
+
+template<typename T>
+using pooled_ptr = std::unique_ptr<T,PoolDeleter<T>>;
+
+template<typename T>
+using arena_ptr = std::unique_ptr<T,ArenaDeleter<T>>;
+
+/**
+ * @brief      the variadic make_unique of perfect_forward.cpp with the
+ *             memory coming from the calling thread's FreeListPool<T>
+ */
+template<typename T,typename... Args>
+pooled_ptr<T> make_pooled(Args&&... args){
+	void* memory = FreeListPool<T>::local().allocate();
+	try{
+		return pooled_ptr<T>(new(memory) T(std::forward<Args>(args)...));
+	}catch(...){
+		FreeListPool<T>::local().deallocate(memory);
+		throw;
+	}
+}
+
+/**
+ * @brief      same with the memory bumped from arena, the pointers must
+ *             be gone before the arena is released
+ */
+template<typename T,typename... Args>
+arena_ptr<T> make_arena(MonotonicArena& arena,Args&&... args){
+	void* memory = arena.allocate(sizeof(T),alignof(T));
+	return arena_ptr<T>(new(memory) T(std::forward<Args>(args)...));
+}
+
+#endif // POOL_H
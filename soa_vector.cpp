@@ -0,0 +1,186 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 22:51:09
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 22:51:09
+*/
+
+#include "bigHeader.h"
+#include "soa_vector.h"
+#include "stopwatch.h"
+
+#include <cstdint>
+
+namespace{
+
+/*
+ 	the cpp_11.cpp fleet record grown to what a scan would look at
+*/
+struct JetPlane{
+	int id;
+	std::string model;
+	double speed;
+	double range;
+	int engines;
+	int passengers;
+};
+
+enum FleetColumn : size_t{
+	fleetId,
+	fleetModel,
+	fleetSpeed,
+	fleetRange,
+	fleetEngines,
+	fleetPassengers
+};
+
+using Fleet = soa_vector<int,std::string,double,double,int,int>;
+
+void expect(bool condition,const char* what){
+	if(!condition){
+		throw std::runtime_error(std::string("soa vector check failed: ") + what);
+	}
+}
+
+template<typename T>
+bool aligned(const T* p){
+	return reinterpret_cast<uintptr_t>(p) % Fleet::alignment == 0;
+}
+
+}
+
+void check_soa_vector(){
+	Fleet fleet;
+	for(int i = 0; i < 1000; i++){
+		fleet.emplace_back(i,"A" + std::to_string(300 + i % 80),800.0 + i,10000.0 - i,2 + 2 * (i % 2),100 + i);
+	}
+	fleet.push_back(Fleet::value_type(1000,"B747",920.0,13000.0,4,416));
+	expect(fleet.size() == 1001,"size after appends");
+
+	expect(aligned(fleet.column<fleetId>().data()),"id column alignment");
+	expect(aligned(fleet.column<fleetModel>().data()),"model column alignment");
+	expect(aligned(fleet.column<fleetSpeed>().data()),"speed column alignment");
+	expect(aligned(fleet.column<fleetPassengers>().data()),"passenger column alignment");
+
+	//rows are references into the columns
+	auto [id,model,speed,range,engines,passengers] = fleet[10];
+	expect(id == 10 && model == "A310" && speed == 810.0 && engines == 2,"row proxy read");
+	speed = 1.5;
+	expect(fleet.column<fleetSpeed>()[10] == 1.5,"row proxy write");
+	fleet[11] = Fleet::value_type(-1,"X",0.0,0.0,0,0);
+	expect(fleet.column<fleetId>()[11] == -1 && fleet.column<fleetModel>()[11] == "X","row assignment");
+
+	int fourEngines = 0;
+	for(auto [rowId,rowModel,rowSpeed,rowRange,rowEngines,rowPassengers] : fleet){
+		fourEngines += rowEngines == 4;
+		rowPassengers += 1;
+	}
+	expect(fourEngines == 500,"row iteration");
+	expect(fleet.column<fleetPassengers>()[0] == 101,"write through row iteration");
+
+	const Fleet& constFleet = fleet;
+	expect(std::get<fleetModel>(constFleet.at(1000)) == "B747","const at");
+	bool thrown = false;
+	try{
+		constFleet.at(1001);
+	}catch(const std::out_of_range&){
+		thrown = true;
+	}
+	expect(thrown,"at out of range");
+
+	fleet.pop_back();
+	expect(fleet.size() == 1000 && fleet.column<fleetModel>().size() == 1000,"pop_back");
+
+	//a row copied from the vector itself while the columns reallocate
+	soa_vector<int,std::string> aliased;
+	aliased.emplace_back(7,"a model name longer than the small string buffer");
+	while(aliased.size() < aliased.capacity()){
+		aliased.emplace_back(0,"");
+	}
+	aliased.emplace_back(std::get<0>(aliased[0]),std::get<1>(aliased[0]));
+	const size_t last = aliased.size() - 1;
+	expect(std::get<0>(aliased[last]) == 7 && std::get<1>(aliased[last]) == std::get<1>(aliased[0]),
+		"emplace_back of its own row");
+	std::cout << "soa vector check passed, " << Fleet::rowBytes << " bytes per row in columns, "
+		<< sizeof(JetPlane) << " in a struct" << std::endl;
+}
+
+namespace{
+
+/*
+ 	one field at a time, the way the fleet is scanned
+*/
+struct ScanResult{
+	long passengers = 0;
+	long fourEngines = 0;
+	double range = 0;
+};
+
+ScanResult scan_aos(const std::vector<JetPlane>& fleet){
+	ScanResult result;
+	for(const JetPlane& plane : fleet){
+		result.passengers += plane.passengers;
+	}
+	for(const JetPlane& plane : fleet){
+		result.fourEngines += plane.engines == 4;
+	}
+	for(const JetPlane& plane : fleet){
+		result.range += plane.range;
+	}
+	return result;
+}
+
+ScanResult scan_soa(const Fleet& fleet){
+	ScanResult result;
+	for(int passengers : fleet.column<fleetPassengers>()){
+		result.passengers += passengers;
+	}
+	for(int engines : fleet.column<fleetEngines>()){
+		result.fourEngines += engines == 4;
+	}
+	for(double range : fleet.column<fleetRange>()){
+		result.range += range;
+	}
+	return result;
+}
+
+template<typename Scan>
+double ns_per_plane(size_t planes,size_t rounds,Scan scan,ScanResult& result){
+	Stopwatch watch;
+	for(size_t r = 0; r < rounds; r++){
+		result = scan();
+	}
+	return watch.nanoseconds() / static_cast<double>(planes * rounds);
+}
+
+}
+
+void bench_soa_vector(size_t planes,size_t rounds){
+	std::vector<JetPlane> aos;
+	aos.reserve(planes);
+	Fleet soa;
+	soa.reserve(planes);
+	for(size_t i = 0; i < planes; i++){
+		const int n = static_cast<int>(i);
+		const std::string model = "Airbus A" + std::to_string(300 + i % 80);
+		aos.push_back(JetPlane{n,model,800.0 + i % 200,9000.0 + i % 5000,2 + 2 * (n % 3 == 0),100 + n % 400});
+		soa.emplace_back(n,model,800.0 + i % 200,9000.0 + i % 5000,2 + 2 * (n % 3 == 0),100 + n % 400);
+	}
+
+	ScanResult aosResult,soaResult;
+	const double aosTime = ns_per_plane(planes,rounds,[&]{
+		return scan_aos(aos);
+	},aosResult);
+	const double soaTime = ns_per_plane(planes,rounds,[&]{
+		return scan_soa(soa);
+	},soaResult);
+	if(aosResult.passengers != soaResult.passengers || aosResult.fourEngines != soaResult.fourEngines
+		|| aosResult.range != soaResult.range){
+		throw std::runtime_error("soa vector bench: scans disagree");
+	}
+
+	std::cout << planes << " planes, passengers + four engine count + range scans" << std::endl;
+	std::cout << "  array of structs (" << sizeof(JetPlane) << " byte rows): " << aosTime << " ns per plane" << std::endl;
+	std::cout << "  soa_vector (" << Fleet::rowBytes << " bytes over 6 columns): " << soaTime
+		<< " ns per plane, " << aosTime / soaTime << "x" << std::endl;
+}
@@ -0,0 +1,385 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "bigHeader.h"
+#include "type_list.h"
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+
+/*
+ 	std::allocator with a minimum alignment, AVX loads of a column never
+ 	straddle a cache line at its start
+*/
+template<typename T,size_t Alignment = 64>
+struct AlignedAllocator{
+	static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+		"AlignedAllocator: Alignment must be a power of two of at least alignof(T)");
+
+	using value_type = T;
+
+	template<typename U>
+	struct rebind{
+		typedef AlignedAllocator<U,Alignment> other;
+	};
+
+	AlignedAllocator() = default;
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U,Alignment>&) noexcept{
+
+	}
+
+	T* allocate(size_t n){
+		return static_cast<T*>(::operator new(n * sizeof(T),std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* p,size_t) noexcept{
+		::operator delete(p,std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U,Alignment>&) const noexcept{
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U,Alignment>&) const noexcept{
+		return false;
+	}
+};
+
+/*
+ 	one column of a soa_vector as a plain pointer range, loops over it
+ 	see contiguous T and nothing else, so the compiler can vectorize them
+*/
+template<typename T>
+class ColumnRange{
+	public:
+		ColumnRange(T* first,size_t count):first(first),count(count){
+
+		}
+
+		T* begin() const{
+			return first;
+		}
+
+		T* end() const{
+			return first + count;
+		}
+
+		T* data() const{
+			return first;
+		}
+
+		size_t size() const{
+			return count;
+		}
+
+		T& operator[](size_t i) const{
+			return first[i];
+		}
+
+	private:
+		T* first;
+		size_t count;
+};
+
+/*
+ 	structure of arrays, every field of a row lives in its own contiguous
+ 	64 byte aligned array
+
+ 	a scan over one field touches only that field's memory, rows are
+ 	tuples of references into the columns
+
+ 		soa_vector<int,std::string,double> fleet;
+ 		fleet.emplace_back(1,"A380",945.0);
+ 		for(double speed : fleet.column<2>()){ ... }
+ 		for(auto [id,model,speed] : fleet){ speed *= 1.1; }
+*/
+template<typename... Ts>
+class soa_vector{
+	static_assert(sizeof...(Ts) > 0,"soa_vector needs at least one column");
+
+	public:
+		static constexpr size_t columns   = sizeof...(Ts);
+		static constexpr size_t alignment = 64;
+		//bytes of one row without padding, an AoS struct usually needs more
+		static constexpr size_t rowBytes  = TupleSize<Ts...>::payload;
+
+		using value_type      = std::tuple<Ts...>;
+		using reference       = std::tuple<Ts&...>;
+		using const_reference = std::tuple<const Ts&...>;
+
+		template<size_t I>
+		using column_type = std::tuple_element_t<I,value_type>;
+
+		template<typename T>
+		using column_vector = std::vector<T,AlignedAllocator<T,alignment>>;
+
+		template<bool Const>
+		class RowIterator{
+			using Owner = std::conditional_t<Const,const soa_vector,soa_vector>;
+
+			public:
+				using iterator_category = std::input_iterator_tag;
+				using value_type        = soa_vector::value_type;
+				using difference_type   = std::ptrdiff_t;
+				using reference         = std::conditional_t<Const,const_reference,soa_vector::reference>;
+				using pointer           = void;
+
+				RowIterator(Owner* owner,size_t index):owner(owner),index(index){
+
+				}
+
+				reference operator*() const{
+					return (*owner)[index];
+				}
+
+				RowIterator& operator++(){
+					++index;
+					return *this;
+				}
+
+				RowIterator operator++(int){
+					RowIterator previous(*this);
+					++index;
+					return previous;
+				}
+
+				bool operator==(const RowIterator& other) const{
+					return index == other.index;
+				}
+
+				bool operator!=(const RowIterator& other) const{
+					return index != other.index;
+				}
+
+			private:
+				Owner* owner;
+				size_t index;
+		};
+
+		using iterator       = RowIterator<false>;
+		using const_iterator = RowIterator<true>;
+
+		soa_vector() = default;
+
+		explicit soa_vector(size_t count){
+			resize(count);
+		}
+
+		size_t size() const{
+			return std::get<0>(data).size();
+		}
+
+		bool empty() const{
+			return size() == 0;
+		}
+
+		size_t capacity() const{
+			return std::get<0>(data).capacity();
+		}
+
+		void reserve(size_t count){
+			reserve(count,Columns());
+		}
+
+		void resize(size_t count){
+			resize(count,Columns());
+		}
+
+		void clear(){
+			clear(Columns());
+		}
+
+		/**
+		 * @brief      appends a row, one argument per column
+		 *
+		 *             when a column throws the columns already appended
+		 *             are rolled back, the rows stay the same length
+		 *             the arguments may refer to rows of this vector, like
+		 *             they may for std::vector::emplace_back
+		 */
+		template<typename... Args>
+		reference emplace_back(Args&&... args){
+			static_assert(sizeof...(Args) == columns,"soa_vector::emplace_back takes one argument per column");
+			if(size() == capacity()){
+				//the row is built before the columns reallocate, the
+				//arguments would dangle after it
+				value_type row(std::forward<Args>(args)...);
+				reserve(std::max<size_t>(8,capacity() * 2));
+				push_back(std::move(row));
+			}else{
+				append(Columns(),std::forward<Args>(args)...);
+			}
+			return (*this)[size() - 1];
+		}
+
+		void push_back(const value_type& row){
+			push_row(row,Columns());
+		}
+
+		void push_back(value_type&& row){
+			push_row(std::move(row),Columns());
+		}
+
+		void pop_back(){
+			pop_back(Columns());
+		}
+
+		reference operator[](size_t i){
+			return row(i,Columns());
+		}
+
+		const_reference operator[](size_t i) const{
+			return row(i,Columns());
+		}
+
+		reference at(size_t i){
+			check_index(i);
+			return (*this)[i];
+		}
+
+		const_reference at(size_t i) const{
+			check_index(i);
+			return (*this)[i];
+		}
+
+		/**
+		 * @brief      column I as a contiguous range
+		 */
+		template<size_t I>
+		ColumnRange<column_type<I>> column(){
+			auto& values = std::get<I>(data);
+			return ColumnRange<column_type<I>>(values.data(),values.size());
+		}
+
+		template<size_t I>
+		ColumnRange<const column_type<I>> column() const{
+			const auto& values = std::get<I>(data);
+			return ColumnRange<const column_type<I>>(values.data(),values.size());
+		}
+
+		/**
+		 * @brief      columns Ns... of every row, nothing is copied
+		 *
+		 *             auto [speeds,ranges] = fleet.project<2,3>();
+		 */
+		template<size_t... Ns>
+		std::tuple<ColumnRange<column_type<Ns>>...> project(){
+			return std::tuple<ColumnRange<column_type<Ns>>...>(column<Ns>()...);
+		}
+
+		template<size_t... Ns>
+		std::tuple<ColumnRange<const column_type<Ns>>...> project() const{
+			return std::tuple<ColumnRange<const column_type<Ns>>...>(column<Ns>()...);
+		}
+
+		/**
+		 * @brief      fields Ns... of row i as references
+		 */
+		template<size_t... Ns>
+		std::tuple<const column_type<Ns>&...> project(size_t i) const{
+			return std::tuple<const column_type<Ns>&...>(std::get<Ns>(data)[i]...);
+		}
+
+		iterator begin(){
+			return iterator(this,0);
+		}
+
+		iterator end(){
+			return iterator(this,size());
+		}
+
+		const_iterator begin() const{
+			return const_iterator(this,0);
+		}
+
+		const_iterator end() const{
+			return const_iterator(this,size());
+		}
+
+	private:
+		using Columns = typename MakeIndexes<columns>::type;
+
+		std::tuple<column_vector<Ts>...> data;
+
+		void check_index(size_t i) const{
+			if(i >= size()){
+				throw std::out_of_range("soa_vector: row " + std::to_string(i)
+					+ " of " + std::to_string(size()));
+			}
+		}
+
+		template<size_t... Ns>
+		reference row(size_t i,Indexes<Ns...>){
+			return reference(std::get<Ns>(data)[i]...);
+		}
+
+		template<size_t... Ns>
+		const_reference row(size_t i,Indexes<Ns...>) const{
+			return const_reference(std::get<Ns>(data)[i]...);
+		}
+
+		template<size_t... Ns>
+		void reserve(size_t count,Indexes<Ns...>){
+			(std::get<Ns>(data).reserve(count),...);
+		}
+
+		template<size_t... Ns>
+		void resize(size_t count,Indexes<Ns...>){
+			(std::get<Ns>(data).resize(count),...);
+		}
+
+		template<size_t... Ns>
+		void clear(Indexes<Ns...>){
+			(std::get<Ns>(data).clear(),...);
+		}
+
+		template<size_t... Ns>
+		void pop_back(Indexes<Ns...>){
+			(std::get<Ns>(data).pop_back(),...);
+		}
+
+		template<size_t... Ns,typename... Args>
+		void append(Indexes<Ns...>,Args&&... args){
+			size_t appended = 0;
+			try{
+				((std::get<Ns>(data).emplace_back(std::forward<Args>(args)),++appended),...);
+			}catch(...){
+				((Ns < appended ? std::get<Ns>(data).pop_back() : void()),...);
+				throw;
+			}
+		}
+
+		template<typename Row,size_t... Ns>
+		void push_row(Row&& row,Indexes<Ns...>){
+			emplace_back(std::get<Ns>(std::forward<Row>(row))...);
+		}
+};
+
+/**
+ * @brief      cherry_pick over a whole soa_vector, the picked columns as
+ *             ranges
+ */
+template<typename... Ts,size_t... Ns>
+std::tuple<ColumnRange<const std::tuple_element_t<Ns,std::tuple<Ts...>>>...>
+cherry_pick_view(const soa_vector<Ts...>& soa,Indexes<Ns...>){
+	return soa.template project<Ns...>();
+}
+
+/*
+ 	fills, reads, writes through row proxies and checks column alignment
+*/
+void check_soa_vector();
+
+/*
+ 	field scans over a JetPlane fleet stored as an array of structs
+ 	against the same fleet in a soa_vector
+*/
+void bench_soa_vector(size_t planes = 1000000,size_t rounds = 20);
+
+#endif // SOA_VECTOR_H
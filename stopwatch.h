@@ -0,0 +1,42 @@
+#ifndef STOPWATCH_H
+#define STOPWATCH_H
+
+#include <chrono>
+
+/*
+ 	small wall clock timer shared by the bench_* functions
+*/
+class Stopwatch{
+	public:
+		Stopwatch():start(std::chrono::steady_clock::now()){
+
+		}
+
+		/**
+		 * @brief      restarts the measurement from now
+		 */
+		void reset(){
+			start = std::chrono::steady_clock::now();
+		}
+
+		/**
+		 * @brief      seconds elapsed since construction or the last reset
+		 */
+		double seconds() const{
+			return std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		}
+
+		/**
+		 * @brief      nanoseconds elapsed since construction or the last reset
+		 */
+		long long nanoseconds() const{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point start;
+};
+
+#endif // STOPWATCH_H
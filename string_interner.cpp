@@ -0,0 +1,54 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 19:48:03
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 19:48:03
+*/
+
+#include "bigHeader.h"
+#include "string_interner.h"
+
+#include <mutex>
+
+StringInterner& StringInterner::global(){
+	static StringInterner interner;
+	return interner;
+}
+
+StrId StringInterner::intern(std::string_view text){
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		const auto found = ids.find(text);
+		if(found != ids.end()){
+			return StrId(found->second);
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	if(strings.size() >= UINT32_MAX){
+		throw std::length_error("StringInterner: out of 32 bit ids");
+	}
+	const auto inserted = ids.emplace(text,static_cast<uint32_t>(strings.size()));
+	if(inserted.second){
+		strings.emplace_back(text);
+	}
+	return StrId(inserted.first->second);
+}
+
+std::optional<StrId> StringInterner::lookup(std::string_view text) const{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	const auto found = ids.find(text);
+	if(found == ids.end()){
+		return std::nullopt;
+	}
+	return StrId(found->second);
+}
+
+std::string_view StringInterner::str(StrId id) const{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	return strings.at(id.value()).view();
+}
+
+size_t StringInterner::size() const{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	return strings.size();
+}
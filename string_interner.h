@@ -0,0 +1,218 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include "bigHeader.h"
+#include "flat_map.h"
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+/*
+ 	32 bit id of an interned string, equal strings have equal ids so
+ 	comparing and hashing are one integer operation
+*/
+class StrId{
+	public:
+		StrId() = default;
+
+		explicit StrId(uint32_t id):id(id){
+
+		}
+
+		uint32_t value() const{
+			return id;
+		}
+
+		friend bool operator==(StrId a,StrId b){
+			return a.id == b.id;
+		}
+
+		friend bool operator!=(StrId a,StrId b){
+			return a.id != b.id;
+		}
+
+		friend bool operator<(StrId a,StrId b){
+			return a.id < b.id;
+		}
+
+	private:
+		uint32_t id = 0;
+};
+
+namespace std{
+	template<>
+	struct hash<StrId>{
+		size_t operator()(StrId id) const{
+			return id.value();
+		}
+	};
+}
+
+/*
+ 	maps every distinct string to a StrId and back
+
+ 	strings are never removed, the views returned by str() stay valid for
+ 	the life of the interner
+ 	intern() takes a unique lock only for strings it has not seen, lookups
+ 	share the lock and never allocate
+*/
+class StringInterner{
+	public:
+		/**
+		 * @brief      the process wide interner
+		 */
+		static StringInterner& global();
+
+		/**
+		 * @brief      id of text, text is copied in the first time
+		 */
+		StrId intern(std::string_view text);
+
+		/**
+		 * @brief      id of text if it was interned before, no allocation
+		 */
+		std::optional<StrId> lookup(std::string_view text) const;
+
+		/**
+		 * @brief      the string of an id handed out by this interner
+		 */
+		std::string_view str(StrId id) const;
+
+		size_t size() const;
+
+	private:
+		mutable std::shared_mutex mutex;
+		FlatStrKeyMap<uint32_t> ids;
+		//deque keeps the inline characters of the keys in place
+		std::deque<FlatKey> strings;
+};
+
+/*
+ 	map keyed by interned strings
+
+ 	string keys are interned on insert, find with a string only looks the
+ 	string up in the interner, find with a StrId is a plain integer hash
+*/
+template<typename T>
+class InternedStrKeyMap{
+	public:
+		using key_type       = StrId;
+		using mapped_type    = T;
+		using map_type       = std::unordered_map<StrId,T>;
+		using value_type     = typename map_type::value_type;
+		using size_type      = size_t;
+		using iterator       = typename map_type::iterator;
+		using const_iterator = typename map_type::const_iterator;
+
+		explicit InternedStrKeyMap(StringInterner& interner = StringInterner::global())
+			:interner(&interner){
+
+		}
+
+		T& operator[](std::string_view key){
+			return entries[interner->intern(key)];
+		}
+
+		T& operator[](StrId key){
+			return entries[key];
+		}
+
+		T& at(std::string_view key){
+			const iterator found = find(key);
+			if(found == end()){
+				throw std::out_of_range("InternedStrKeyMap::at: no key " + std::string(key));
+			}
+			return found->second;
+		}
+
+		template<typename... Args>
+		std::pair<iterator,bool> emplace(std::string_view key,Args&&... args){
+			return entries.try_emplace(interner->intern(key),std::forward<Args>(args)...);
+		}
+
+		template<typename Pair>
+		std::pair<iterator,bool> insert(Pair&& value){
+			return emplace(std::string_view(value.first),std::forward<Pair>(value).second);
+		}
+
+		template<typename Value>
+		std::pair<iterator,bool> insert_or_assign(std::string_view key,Value&& value){
+			return entries.insert_or_assign(interner->intern(key),std::forward<Value>(value));
+		}
+
+		iterator find(std::string_view key){
+			const std::optional<StrId> id = interner->lookup(key);
+			return id ? entries.find(*id) : entries.end();
+		}
+
+		const_iterator find(std::string_view key) const{
+			const std::optional<StrId> id = interner->lookup(key);
+			return id ? entries.find(*id) : entries.end();
+		}
+
+		iterator find(StrId key){
+			return entries.find(key);
+		}
+
+		const_iterator find(StrId key) const{
+			return entries.find(key);
+		}
+
+		size_t count(std::string_view key) const{
+			return find(key) != end();
+		}
+
+		size_t erase(std::string_view key){
+			const std::optional<StrId> id = interner->lookup(key);
+			return id ? entries.erase(*id) : 0;
+		}
+
+		/**
+		 * @brief      the string of a key seen while iterating
+		 */
+		std::string_view str(StrId key) const{
+			return interner->str(key);
+		}
+
+		void clear(){
+			entries.clear();
+		}
+
+		void reserve(size_t n){
+			entries.reserve(n);
+		}
+
+		size_t size() const{
+			return entries.size();
+		}
+
+		bool empty() const{
+			return entries.empty();
+		}
+
+		iterator begin(){
+			return entries.begin();
+		}
+
+		iterator end(){
+			return entries.end();
+		}
+
+		const_iterator begin() const{
+			return entries.begin();
+		}
+
+		const_iterator end() const{
+			return entries.end();
+		}
+
+	private:
+		StringInterner* interner;
+		map_type entries;
+};
+
+#endif // STRING_INTERNER_H
@@ -7,20 +7,11 @@
 
 
 #include "bigHeader.h"
-
-template<typename T>
-using StrKeyMap = std::map<std::string ,T>;
-
-template<typename Stream>
-struct StreamDeleter{
-	void operator()(Stream* os)const{
-		os->close();
-		delete os;
-	}
-};
-
-template<typename Stream>
-using StreamPtr = std::unique_ptr<Stream,StreamDeleter<Stream>>;
+#include "template_alias.h"
+#include "async_sink.h"
+#include "arena.h"
+#include "heap_counter.h"
+#include "stopwatch.h"
 
 
 /*
@@ -40,10 +31,36 @@ void template_alias_check(){
 	StrKeyMap<std::string> myKeyMap;
 	myKeyMap["first"] = "good";
 	myKeyMap.insert(std::pair<std::string,std::string>("adeeb","is a good boy"));
+	//operator[] of std::map needs a std::string key, find does not
+	myKeyMap.find("first");
 	myKeyMap.clear();
+
+	/*
+	 	same interface, open addressing with the keys stored inline
+	 */
+	StrKeyMap<std::string,FlatBackend> flatKeyMap;
+	flatKeyMap["first"] = "good";
+	flatKeyMap.insert(std::pair<std::string,std::string>("adeeb","is a good boy"));
+	flatKeyMap.clear();
+
+	{
+		MonotonicArena arena;
+		ArenaResource resource(arena);
+		pmr::StrKeyMap<std::pmr::string> arenaKeyMap(&resource);
+		arenaKeyMap["first"] = "good";
+		arenaKeyMap.emplace("adeeb","is a good boy");
+	}
 	StreamPtr<std::ofstream> p_log(new std::ofstream("mylog.log"));
 	*p_log << "Log Statement";
 	//stream gets closed and deleted here
+	p_log.reset();
+
+	/*
+	 	same logger without blocking on the file, the writes happen on
+	 	the sink's writer thread and close() drains it
+	 */
+	StreamPtr<AsyncFileSink> p_async_log(new AsyncFileSink("mylog_async.log"));
+	*p_async_log << "Log Statement";
 
 	/*
 	 	local types as template arguments
@@ -77,3 +94,79 @@ void template_alias_check(){
 	return;
 }
 
+namespace{
+
+/*
+ 	looks every key up through string_view and const char*, returns how
+ 	many of them were found and the heap traffic of the loop
+*/
+template<typename Map>
+size_t lookup_loop(const Map& map,const std::vector<std::string_view>& views,
+	const std::vector<const char*>& names,size_t lookups,HeapCounters& traffic){
+	const HeapCounters before = heapCounters();
+	size_t found = 0;
+	for(size_t i = 0; i < lookups; i++){
+		found += map.find(views[i % views.size()]) != map.end();
+		found += map.count(names[i % names.size()]);
+	}
+	traffic = heapCounters() - before;
+	return found;
+}
+
+template<typename Backend>
+void check_backend(const char* backend,const std::vector<std::string>& keys,size_t lookups){
+	StrKeyMap<size_t,Backend> map;
+	for(size_t i = 0; i < keys.size(); i++){
+		map[keys[i]] = i;
+	}
+	std::vector<std::string_view> views(keys.begin(),keys.end());
+	std::vector<const char*> names;
+	for(const std::string& key : keys){
+		names.push_back(key.c_str());
+	}
+
+	HeapCounters traffic;
+	Stopwatch watch;
+	const size_t found = lookup_loop(map,views,names,lookups,traffic);
+	const double seconds = watch.seconds();
+	std::cout << backend << ": " << seconds / (2 * lookups) * 1e9 << " ns/lookup, "
+		<< traffic.allocations << " allocations" << std::endl;
+	if(found != 2 * lookups || traffic.allocations != 0){
+		throw std::runtime_error(std::string(backend) + " lookups allocate or miss keys");
+	}
+}
+
+}
+
+void check_str_key_lookup(size_t lookups){
+	std::vector<std::string> keys;
+	for(size_t i = 0; i < 1000; i++){
+		//long enough to leave the small string buffer of std::string
+		keys.push_back("configuration.key." + std::to_string(i));
+	}
+	check_backend<TreeBackend>("std::map  ",keys,lookups);
+	check_backend<FlatBackend>("flat      ",keys,lookups);
+	check_backend<SortedBackend>("sorted    ",keys,lookups);
+	check_backend<InternedBackend>("interned  ",keys,lookups);
+
+	//with the ids in hand a lookup is an integer hash
+	StrKeyMap<size_t,InternedBackend> interned;
+	std::vector<StrId> ids;
+	for(size_t i = 0; i < keys.size(); i++){
+		ids.push_back(StringInterner::global().intern(keys[i]));
+		interned[ids.back()] = i;
+	}
+	const HeapCounters before = heapCounters();
+	Stopwatch watch;
+	size_t sum = 0;
+	for(size_t i = 0; i < lookups; i++){
+		sum += interned.find(ids[i % ids.size()])->second;
+	}
+	const double seconds = watch.seconds();
+	const HeapCounters traffic = heapCounters() - before;
+	std::cout << "StrId     : " << seconds / lookups * 1e9 << " ns/lookup, "
+		<< traffic.allocations << " allocations (" << sum << ")" << std::endl;
+	if(traffic.allocations != 0 || StringInterner::global().str(ids[7]) != keys[7]){
+		throw std::runtime_error("interned lookups allocate or return the wrong key");
+	}
+}
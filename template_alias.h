@@ -1,6 +1,72 @@
 #ifndef TEMPLATE_ALIAS_H
 #define TEMPLATE_ALIAS_H
 
+#include "bigHeader.h"
+#include "flat_map.h"
+#include "string_interner.h"
+#include <memory_resource>
+
+/*
+ 	backends of StrKeyMap, all of them take the same operator[], insert,
+ 	emplace, find, count, at, erase and iteration
+ 	find and count take a std::string_view or const char* without
+ 	building a std::string
+
+ 	TreeBackend      std::map with std::less<>, ordered, stable nodes
+ 	FlatBackend      FlatStrKeyMap, SwissTable style open addressing
+ 	SortedBackend    SortedStrKeyMap, sorted vector for read mostly tables
+ 	InternedBackend  InternedStrKeyMap, keys are StrIds of the global
+ 	                 StringInterner
+*/
+struct TreeBackend{
+	template<typename T>
+	using map = std::map<std::string,T,std::less<>>;
+};
+
+struct FlatBackend{
+	template<typename T>
+	using map = FlatStrKeyMap<T>;
+};
+
+struct SortedBackend{
+	template<typename T>
+	using map = SortedStrKeyMap<T>;
+};
+
+struct InternedBackend{
+	template<typename T>
+	using map = InternedStrKeyMap<T>;
+};
+
+template<typename T,typename Backend = TreeBackend>
+using StrKeyMap = typename Backend::template map<T>;
+
+/*
+ 	same map with keys and nodes from a std::pmr::memory_resource,
+ 	with an ArenaResource a whole map goes away with one arena reset
+*/
+namespace pmr{
+	template<typename T>
+	using StrKeyMap = std::pmr::map<std::pmr::string ,T,std::less<>>;
+}
+
+template<typename Stream>
+struct StreamDeleter{
+	void operator()(Stream* os)const{
+		os->close();
+		delete os;
+	}
+};
+
+template<typename Stream>
+using StreamPtr = std::unique_ptr<Stream,StreamDeleter<Stream>>;
+
 void template_alias_check();
 
+/*
+ 	string_view / const char* lookups on every backend, checks with the
+ 	heap counters that the lookup loops do not allocate
+*/
+void check_str_key_lookup(size_t lookups = 1000000);
+
 #endif // TEMPLATE_ALIAS_H
@@ -0,0 +1,330 @@
+/*
+* @Author: adeeb2358
+* @Date:   2026-10-17 21:40:52
+* @Last Modified by:   adeeb2358
+* @Last Modified time: 2026-10-17 21:40:52
+*/
+
+#include "bigHeader.h"
+#include "thread_pool.h"
+#include "move_semantics.h"
+#include "stopwatch.h"
+
+#include <cmath>
+#include <omp.h>
+
+namespace{
+
+//the pool and worker index of the calling thread, null off the workers
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+//xorshift for picking steal victims
+thread_local uint64_t victimSeed = 0x9E3779B97F4A7C15ULL;
+
+size_t next_victim(size_t workers){
+	victimSeed ^= victimSeed << 13;
+	victimSeed ^= victimSeed >> 7;
+	victimSeed ^= victimSeed << 17;
+	return static_cast<size_t>(victimSeed % workers);
+}
+
+const size_t injectedCapacity = 4096;
+const int idleSpins = 64;
+
+}
+
+ThreadPool::ThreadPool(size_t threads):injected(injectedCapacity){
+	if(threads == 0){
+		threads = std::max(1u,std::thread::hardware_concurrency());
+	}
+	//every deque exists before any worker starts stealing
+	for(size_t i = 0; i < threads; i++){
+		workers.emplace_back(new Worker());
+	}
+	for(size_t i = 0; i < threads; i++){
+		workers[i]->thread = std::thread(&ThreadPool::worker_loop,this,i);
+	}
+}
+
+ThreadPool::~ThreadPool(){
+	help_until([this]{
+		return unfinished.load(std::memory_order_acquire) == 0;
+	});
+	stopping.store(true);
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepSignal.notify_all();
+	for(auto& worker : workers){
+		worker->thread.join();
+	}
+}
+
+void ThreadPool::wait_all(){
+	if(currentPool == this){
+		//the calling task itself is unfinished, this would never return
+		throw std::logic_error("ThreadPool::wait_all called from one of its own tasks");
+	}
+	help_until([this]{
+		return unfinished.load(std::memory_order_acquire) == 0;
+	});
+}
+
+bool ThreadPool::run_one(){
+	Task* task = find_task();
+	if(!task){
+		return false;
+	}
+	execute(task);
+	return true;
+}
+
+void ThreadPool::schedule(Task* task){
+	unfinished.fetch_add(1,std::memory_order_relaxed);
+	if(currentPool == this){
+		workers[currentWorker]->deque.push(task);
+	}else{
+		injected.push(std::move(task));
+	}
+	epoch.fetch_add(1);
+	if(sleepers.load() != 0){
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		sleepSignal.notify_one();
+	}
+}
+
+ThreadPool::Task* ThreadPool::find_task(){
+	Task* task = nullptr;
+	if(currentPool == this){
+		task = workers[currentWorker]->deque.pop();
+		if(task){
+			return task;
+		}
+	}
+	if(injected.try_pop(task)){
+		return task;
+	}
+	const size_t count = workers.size();
+	const size_t first = next_victim(count);
+	for(size_t i = 0; i < count; i++){
+		const size_t victim = (first + i) % count;
+		if(currentPool == this && victim == currentWorker){
+			continue;
+		}
+		task = workers[victim]->deque.steal();
+		if(task){
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+void ThreadPool::execute(Task* task){
+	task->run();
+	delete task;
+	unfinished.fetch_sub(1,std::memory_order_acq_rel);
+}
+
+void ThreadPool::worker_loop(size_t index){
+	currentPool = this;
+	currentWorker = index;
+	victimSeed += index * 0x2545F4914F6CDD1DULL;
+	for(;;){
+		if(run_one()){
+			continue;
+		}
+		if(stopping.load() && unfinished.load(std::memory_order_acquire) == 0){
+			break;
+		}
+		bool found = false;
+		for(int spin = 0; spin < idleSpins && !found; spin++){
+			std::this_thread::yield();
+			found = run_one();
+		}
+		if(found){
+			continue;
+		}
+		//read the epoch before the last look so a task scheduled after it
+		//either is found or changes the epoch
+		const uint64_t seen = epoch.load();
+		sleepers.fetch_add(1);
+		if(run_one()){
+			sleepers.fetch_sub(1);
+			continue;
+		}
+		{
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepSignal.wait(lock,[&]{
+				return epoch.load() != seen || stopping.load();
+			});
+		}
+		sleepers.fetch_sub(1);
+	}
+	currentPool = nullptr;
+}
+
+namespace{
+
+long fibonacci_task(ThreadPool& pool,int n){
+	if(n < 12){
+		return n < 2 ? n : fibonacci_task(pool,n - 1) + fibonacci_task(pool,n - 2);
+	}
+	auto left = pool.submit([&pool,n]{
+		return fibonacci_task(pool,n - 1);
+	});
+	const long right = fibonacci_task(pool,n - 2);
+	return left.get() + right;
+}
+
+void expect(bool condition,const char* what){
+	if(!condition){
+		throw std::runtime_error(std::string("thread pool check failed: ") + what);
+	}
+}
+
+}
+
+void check_thread_pool(){
+	ThreadPool pool(4);
+
+	//move only captures, std::function could not hold either lambda
+	MyMoveOnlyType buffer;
+	buffer.data()[0] = 7;
+	auto fromBuffer = pool.submit([buffer = std::move(buffer)]{
+		return buffer.data()[0] * 6;
+	});
+	auto fromUnique = pool.submit([value = std::make_unique<int>(41)]{
+		return *value + 1;
+	});
+	expect(fromBuffer.get() == 42,"MyMoveOnlyType capture");
+	expect(fromUnique.get() == 42,"unique_ptr capture");
+
+	auto failing = pool.submit([]() -> int{
+		throw std::runtime_error("task failure");
+	});
+	bool rethrown = false;
+	try{
+		failing.get();
+	}catch(const std::runtime_error&){
+		rethrown = true;
+	}
+	expect(rethrown,"exception from submit");
+
+	//tasks that wait for the tasks they spawned
+	expect(fibonacci_task(pool,25) == 75025,"nested tasks");
+
+	std::atomic<size_t> counter{0};
+	for(size_t i = 0; i < 10000; i++){
+		pool.submit([&counter]{
+			counter.fetch_add(1,std::memory_order_relaxed);
+		});
+	}
+	pool.wait_all();
+	expect(counter.load() == 10000,"wait_all");
+
+	std::vector<size_t> doubled(1000003);
+	pool.parallel_for(0,doubled.size(),1000,[&doubled](size_t i){
+		doubled[i] = i * 2;
+	});
+	for(size_t i = 0; i < doubled.size(); i++){
+		expect(doubled[i] == i * 2,"parallel_for");
+	}
+
+	rethrown = false;
+	try{
+		pool.parallel_for(0,10000,16,[](size_t i){
+			if(i == 5000){
+				throw std::runtime_error("iteration failure");
+			}
+		});
+	}catch(const std::runtime_error&){
+		rethrown = true;
+	}
+	expect(rethrown,"exception from parallel_for");
+
+	std::cout << "thread pool check passed with " << pool.size() << " workers" << std::endl;
+}
+
+namespace{
+
+//a few hundred nanoseconds of work per task
+double task_work(size_t i){
+	double sum = 0;
+	for(size_t k = 1; k <= 64; k++){
+		sum += std::sqrt(static_cast<double>(i + k));
+	}
+	return sum;
+}
+
+void report(const char* name,size_t tasks,double seconds,double baseline){
+	std::cout << "  " << name << ": " << seconds * 1e9 / tasks << " ns per task, "
+		<< baseline / seconds << "x of sequential" << std::endl;
+}
+
+}
+
+void bench_thread_pool(size_t tasks){
+	std::vector<double> out(tasks);
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", "
+		<< tasks << " tasks" << std::endl;
+
+	Stopwatch watch;
+	for(size_t i = 0; i < tasks; i++){
+		out[i] = task_work(i);
+	}
+	const double sequential = watch.seconds();
+	report("sequential            ",tasks,sequential,sequential);
+
+	ThreadPool pool;
+	watch.reset();
+	for(size_t i = 0; i < tasks; i++){
+		pool.submit([&out,i]{
+			out[i] = task_work(i);
+		});
+	}
+	pool.wait_all();
+	report("pool submit + wait_all",tasks,watch.seconds(),sequential);
+
+	for(size_t grain : {1,64}){
+		watch.reset();
+		pool.parallel_for(0,tasks,grain,[&out](size_t i){
+			out[i] = task_work(i);
+		});
+		const std::string name = "pool parallel_for " + std::to_string(grain) + (grain < 10 ? "   " : "  ");
+		report(name.c_str(),tasks,watch.seconds(),sequential);
+	}
+
+	watch.reset();
+	#pragma omp parallel for schedule(dynamic,1)
+	for(long i = 0; i < static_cast<long>(tasks); i++){
+		out[i] = task_work(i);
+	}
+	report("omp dynamic,1         ",tasks,watch.seconds(),sequential);
+
+	watch.reset();
+	#pragma omp parallel for schedule(static)
+	for(long i = 0; i < static_cast<long>(tasks); i++){
+		out[i] = task_work(i);
+	}
+	report("omp static            ",tasks,watch.seconds(),sequential);
+
+	//thread creation dominates, a slice of the tasks is enough to see it
+	const size_t threadTasks = std::min<size_t>(tasks,10000);
+	const size_t batch = 64;
+	watch.reset();
+	for(size_t first = 0; first < threadTasks; first += batch){
+		std::vector<std::thread> threads;
+		for(size_t i = first; i < std::min(first + batch,threadTasks); i++){
+			threads.emplace_back([&out,i]{
+				out[i] = task_work(i);
+			});
+		}
+		for(std::thread& thread : threads){
+			thread.join();
+		}
+	}
+	report("std::thread per task  ",threadTasks,watch.seconds(),sequential * threadTasks / tasks);
+}
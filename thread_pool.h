@@ -0,0 +1,372 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "bigHeader.h"
+#include "mpmc_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/*
+ 	Chase-Lev work stealing deque of pointers (Le, Pop, Cohen, Zappa
+ 	Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models")
+
+ 	the owner thread pushes and pops at the bottom like a stack, any other
+ 	thread steals from the top, only the last element is ever contended
+ 	the array doubles when full, old arrays are kept until the deque dies
+ 	because a thief may still be reading them
+*/
+template<typename T>
+class ChaseLevDeque{
+	public:
+		explicit ChaseLevDeque(size_t capacity = 256){
+			size_t rounded = 2;
+			while(rounded < capacity){
+				rounded <<= 1;
+			}
+			arrays.emplace_back(new Array(rounded));
+			array.store(arrays.back().get(),std::memory_order_relaxed);
+		}
+
+		ChaseLevDeque(const ChaseLevDeque&) = delete;
+		ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+		/**
+		 * @brief      owner only
+		 */
+		void push(T* value){
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_acquire);
+			Array* a = array.load(std::memory_order_relaxed);
+			if(b - t > static_cast<int64_t>(a->mask)){
+				a = grow(a,t,b);
+			}
+			a->put(b,value);
+			//release publishes the element and what it points to to thieves
+			bottom.store(b + 1,std::memory_order_release);
+		}
+
+		/**
+		 * @brief      owner only, the newest element or nullptr
+		 */
+		T* pop(){
+			const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			Array* a = array.load(std::memory_order_relaxed);
+			//seq_cst store and load instead of the paper's fence, the same
+			//ordering against steal() and ThreadSanitizer understands it
+			bottom.store(b,std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_seq_cst);
+			if(t > b){
+				bottom.store(b + 1,std::memory_order_relaxed);
+				return nullptr;
+			}
+			T* value = a->get(b);
+			if(t == b){
+				//last element, race the thieves for it
+				if(!top.compare_exchange_strong(t,t + 1,std::memory_order_seq_cst,std::memory_order_relaxed)){
+					value = nullptr;
+				}
+				bottom.store(b + 1,std::memory_order_relaxed);
+			}
+			return value;
+		}
+
+		/**
+		 * @brief      any thread, the oldest element or nullptr when empty or
+		 *             when another thread won the race
+		 */
+		T* steal(){
+			int64_t t = top.load(std::memory_order_seq_cst);
+			const int64_t b = bottom.load(std::memory_order_seq_cst);
+			if(t >= b){
+				return nullptr;
+			}
+			T* value = array.load(std::memory_order_acquire)->get(t);
+			if(!top.compare_exchange_strong(t,t + 1,std::memory_order_seq_cst,std::memory_order_relaxed)){
+				return nullptr;
+			}
+			return value;
+		}
+
+		bool empty() const{
+			return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Array{
+			explicit Array(size_t capacity):mask(capacity - 1),slots(new std::atomic<T*>[capacity]){
+
+			}
+
+			T* get(int64_t i) const{
+				return slots[i & mask].load(std::memory_order_relaxed);
+			}
+
+			void put(int64_t i,T* value){
+				slots[i & mask].store(value,std::memory_order_relaxed);
+			}
+
+			size_t mask;
+			std::unique_ptr<std::atomic<T*>[]> slots;
+		};
+
+		Array* grow(Array* old,int64_t t,int64_t b){
+			arrays.emplace_back(new Array((old->mask + 1) * 2));
+			Array* bigger = arrays.back().get();
+			for(int64_t i = t; i < b; i++){
+				bigger->put(i,old->get(i));
+			}
+			array.store(bigger,std::memory_order_release);
+			return bigger;
+		}
+
+		alignas(64) std::atomic<int64_t> top{0};
+		alignas(64) std::atomic<int64_t> bottom{0};
+		std::atomic<Array*> array;
+		//only the owner touches this, grow is owner only
+		std::vector<std::unique_ptr<Array>> arrays;
+};
+
+class ThreadPool;
+
+/*
+ 	result of ThreadPool::submit
+
+ 	wait and get run other pool tasks while the result is not ready, so a
+ 	task may wait for the tasks it submitted without tying up its worker
+*/
+template<typename R>
+class TaskHandle{
+	public:
+		TaskHandle(ThreadPool* pool,std::future<R> future):pool(pool),future(std::move(future)){
+
+		}
+
+		bool ready() const{
+			return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		void wait() const;
+
+		/**
+		 * @brief      the task's result, rethrows what the task threw
+		 */
+		R get(){
+			wait();
+			return future.get();
+		}
+
+	private:
+		ThreadPool* pool;
+		std::future<R> future;
+};
+
+/*
+ 	work stealing thread pool
+
+ 	every worker owns a ChaseLevDeque, tasks submitted from a worker go to
+ 	the bottom of its own deque and run newest first, idle workers steal
+ 	the oldest task of a random victim, tasks from other threads enter
+ 	through a shared MPMCQueue
+ 	tasks are type erased into one heap node each, so move only callables
+ 	(a lambda owning a MyMoveOnlyType or a unique_ptr) are fine
+
+ 		ThreadPool pool;
+ 		auto handle = pool.submit([p = std::make_unique<int>(41)]{ return *p + 1; });
+ 		pool.parallel_for(0,n,1024,[&](size_t i){ out[i] = in[i] * 2; });
+ 		handle.get();
+*/
+class ThreadPool{
+	public:
+		/**
+		 * @brief      threads workers, hardware_concurrency when 0
+		 */
+		explicit ThreadPool(size_t threads = 0);
+
+		/**
+		 * @brief      runs everything still queued, then joins the workers
+		 */
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief      schedules func() and returns a handle to its result
+		 */
+		template<typename Func>
+		auto submit(Func&& func){
+			using Callable = std::decay_t<Func>;
+			using Result = std::invoke_result_t<Callable&>;
+			std::promise<Result> promise;
+			TaskHandle<Result> handle(this,promise.get_future());
+			spawn([func = Callable(std::forward<Func>(func)),promise = std::move(promise)]() mutable{
+				try{
+					if constexpr(std::is_void<Result>::value){
+						func();
+						promise.set_value();
+					}else{
+						promise.set_value(func());
+					}
+				}catch(...){
+					promise.set_exception(std::current_exception());
+				}
+			});
+			return handle;
+		}
+
+		/**
+		 * @brief      calls func(i) for every i in [begin, end) and returns
+		 *             when all calls are done
+		 *
+		 *             the range is halved until a piece is at most grain
+		 *             long, the upper halves become stealable tasks, the
+		 *             calling thread works on the range too
+		 *             the first exception thrown by func is rethrown here
+		 */
+		template<typename Func>
+		void parallel_for(size_t begin,size_t end,size_t grain,const Func& func){
+			if(begin >= end){
+				return;
+			}
+			ForState state;
+			state.remaining.store(end - begin,std::memory_order_relaxed);
+			split(begin,end,grain ? grain : 1,func,state);
+			help_until([&state]{
+				return state.remaining.load(std::memory_order_acquire) == 0;
+			});
+			if(state.error){
+				std::rethrow_exception(state.error);
+			}
+		}
+
+		/**
+		 * @brief      returns once every task submitted so far, and every
+		 *             task those spawned, has finished, helps meanwhile
+		 *             throws std::logic_error when called from a pool task
+		 */
+		void wait_all();
+
+		/**
+		 * @brief      runs one queued task on the calling thread
+		 *
+		 * @return     false when no task could be found
+		 */
+		bool run_one();
+
+		/**
+		 * @brief      run_one until done() is true, yields while idle
+		 */
+		template<typename Done>
+		void help_until(Done done){
+			while(!done()){
+				if(!run_one()){
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		size_t size() const{
+			return workers.size();
+		}
+
+	private:
+		struct Task{
+			virtual ~Task() = default;
+			virtual void run() = 0;
+		};
+
+		template<typename Callable>
+		struct FunctionTask : Task{
+			explicit FunctionTask(Callable&& callable):callable(std::move(callable)){
+
+			}
+
+			void run() override{
+				callable();
+			}
+
+			Callable callable;
+		};
+
+		struct ForState{
+			std::atomic<size_t> remaining{0};
+			std::atomic<bool> failed{false};
+			std::exception_ptr error;
+		};
+
+		struct Worker{
+			ChaseLevDeque<Task> deque;
+			std::thread thread;
+		};
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		MPMCQueue<Task*> injected;
+		std::atomic<size_t> unfinished{0};
+		std::atomic<bool> stopping{false};
+
+		//idle workers sleep here, epoch changes on every new task
+		std::mutex sleepMutex;
+		std::condition_variable sleepSignal;
+		std::atomic<uint64_t> epoch{0};
+		std::atomic<size_t> sleepers{0};
+
+		template<typename Callable>
+		void spawn(Callable&& callable){
+			schedule(new FunctionTask<std::decay_t<Callable>>(std::forward<Callable>(callable)));
+		}
+
+		template<typename Func>
+		void split(size_t begin,size_t end,size_t grain,const Func& func,ForState& state){
+			while(end - begin > grain){
+				const size_t middle = begin + (end - begin) / 2;
+				spawn([this,middle,end,grain,&func,&state]{
+					split(middle,end,grain,func,state);
+				});
+				end = middle;
+			}
+			if(!state.failed.load(std::memory_order_relaxed)){
+				try{
+					for(size_t i = begin; i < end; i++){
+						func(i);
+					}
+				}catch(...){
+					if(!state.failed.exchange(true)){
+						state.error = std::current_exception();
+					}
+				}
+			}
+			state.remaining.fetch_sub(end - begin,std::memory_order_acq_rel);
+		}
+
+		void schedule(Task* task);
+		Task* find_task();
+		void execute(Task* task);
+		void worker_loop(size_t index);
+};
+
+template<typename R>
+void TaskHandle<R>::wait() const{
+	pool->help_until([this]{
+		return ready();
+	});
+}
+
+/*
+ 	self check of submit, move only tasks, nested tasks, parallel_for
+ 	and exceptions
+*/
+void check_thread_pool();
+
+/*
+ 	fine grained tasks through the pool (submit and parallel_for) against
+ 	openmp parallel for and one std::thread per task
+*/
+void bench_thread_pool(size_t tasks = 100000);
+
+#endif // THREAD_POOL_H
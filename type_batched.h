@@ -0,0 +1,119 @@
+#ifndef TYPE_BATCHED_H
+#define TYPE_BATCHED_H
+
+#include "bigHeader.h"
+#include "type_list.h"
+
+#include <type_traits>
+
+/*
+ 	heterogeneous container without a base class, one std::vector per type
+
+ 	objects of the same type sit next to each other, for_each walks the
+ 	batches one type at a time so every call is a direct, inlinable call
+ 	of that type's member instead of a vtable call per object
+ 	the order between objects of different types is not kept
+
+ 		TypeBatchedVector<SmallPlaneModel,PropPlaneModel,FloatPlaneModel> fleet;
+ 		fleet.emplace<PropPlaneModel>(...);
+ 		fleet.for_each([&](const auto& plane){ fuel += plane.fuelPerHour(); });
+*/
+template<typename... Ts>
+class TypeBatchedVector{
+	static_assert(sizeof...(Ts) > 0,"TypeBatchedVector needs at least one type");
+
+	public:
+		static constexpr size_t types = sizeof...(Ts);
+
+		template<typename T>
+		static constexpr size_t index = TypeIndex<T,Ts...>::value;
+
+		template<typename T,typename... Args>
+		T& emplace(Args&&... args){
+			return batch<T>().emplace_back(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void push_back(T&& value){
+			using Type = std::decay_t<T>;
+			batch<Type>().push_back(std::forward<T>(value));
+		}
+
+		/**
+		 * @brief      all objects of type T, contiguous
+		 */
+		template<typename T>
+		std::vector<T>& batch(){
+			return std::get<index<T>>(batches);
+		}
+
+		template<typename T>
+		const std::vector<T>& batch() const{
+			return std::get<index<T>>(batches);
+		}
+
+		/**
+		 * @brief      calls f on every object, batch by batch, f has to take
+		 *             every type (a generic lambda or an overload set)
+		 */
+		template<typename Func>
+		void for_each(Func&& f){
+			std::apply([&f](auto&... vectors){
+				(for_each_in(vectors,f),...);
+			},batches);
+		}
+
+		template<typename Func>
+		void for_each(Func&& f) const{
+			std::apply([&f](const auto&... vectors){
+				(for_each_in(vectors,f),...);
+			},batches);
+		}
+
+		/**
+		 * @brief      calls f once per type with the whole std::vector<T>
+		 */
+		template<typename Func>
+		void for_each_batch(Func&& f){
+			std::apply([&f](auto&... vectors){
+				(f(vectors),...);
+			},batches);
+		}
+
+		template<typename Func>
+		void for_each_batch(Func&& f) const{
+			std::apply([&f](const auto&... vectors){
+				(f(vectors),...);
+			},batches);
+		}
+
+		size_t size() const{
+			size_t total = 0;
+			for_each_batch([&total](const auto& vector){
+				total += vector.size();
+			});
+			return total;
+		}
+
+		bool empty() const{
+			return size() == 0;
+		}
+
+		void clear(){
+			for_each_batch([](auto& vector){
+				vector.clear();
+			});
+		}
+
+	private:
+		std::tuple<std::vector<Ts>...> batches;
+
+		template<typename Vector,typename Func>
+		static void for_each_in(Vector& vector,Func& f){
+			for(auto& value : vector){
+				f(value);
+			}
+		}
+};
+
+#endif // TYPE_BATCHED_H
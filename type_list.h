@@ -0,0 +1,139 @@
+#ifndef TYPE_LIST_H
+#define TYPE_LIST_H
+
+#include "bigHeader.h"
+
+#include <cstddef>
+
+/*
+	traversing template parameter pack
+*/
+
+
+/**
+ * @brief      footprint of a std::tuple of Types
+ *
+ *             value is what the tuple really takes, alignment padding
+ *             included, payload is the plain sum of sizeof, what the
+ *             fields take packed with no padding (a soa_vector row),
+ *             padding is the difference, see layout.h to shrink it
+ *
+ * @tparam     Types  the field types
+ */
+template<typename... Types>
+struct TupleSize;
+
+template<typename Head, typename... Tail> // traverse types
+                                          //
+struct TupleSize<Head, Tail...>
+{
+    static constexpr size_t payload   = sizeof(Head) + TupleSize<Tail...>::payload;
+    static constexpr size_t value     = sizeof(std::tuple<Head, Tail...>);
+    static constexpr size_t alignment = alignof(std::tuple<Head, Tail...>);
+    static constexpr size_t padding   = value - payload;
+};
+
+/**
+ * @brief      end recursion
+ */
+template<> struct TupleSize<>   // end recursion
+{
+    static constexpr size_t payload   = 0;
+    static constexpr size_t value     = 0;
+    static constexpr size_t alignment = 1;
+    static constexpr size_t padding   = 0;
+};
+
+/*
+ 	end of traversing parameter packs for size requitements
+*/
+
+/*
+ 	Mested variadic templates
+*/
+
+/**
+ * @brief      pairs up two type lists of the same length
+ *
+ * @tparam     Args1  the first types of the pairs
+ */
+template<typename... Args1>
+struct zip{
+	template<typename... Args2>
+	struct with{
+		typedef std::tuple<std::pair<Args1,Args2>...> type;
+	};
+};
+
+/*
+ 	template with two  parameter pack
+
+ */
+template <size_t... Ns>
+struct Indexes
+{};
+
+/*
+ 	MakeIndexes<N>::type is Indexes<0, 1, ..., N - 1>
+*/
+template<size_t N,size_t... Ns>
+struct MakeIndexes : MakeIndexes<N - 1,N - 1,Ns...>
+{};
+
+template<size_t... Ns>
+struct MakeIndexes<0,Ns...>
+{
+	typedef Indexes<Ns...> type;
+};
+
+/*
+ 	TypeIndex<T, Ts...>::value is the position of T in Ts..., a T that
+ 	is not in the list does not compile
+*/
+template<typename T, typename... Ts>
+struct TypeIndex;
+
+template<typename T, typename... Tail>
+struct TypeIndex<T, T, Tail...>
+{
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename Head, typename... Tail>
+struct TypeIndex<T, Head, Tail...>
+{
+	static constexpr size_t value = 1 + TypeIndex<T, Tail...>::value;
+};
+
+template<typename... Ts, size_t... Ns>
+auto cherry_pick(const std::tuple<Ts...>& t, Indexes<Ns...>) ->
+    decltype(std::make_tuple(std::get<Ns>(t)...))
+{
+    return std::make_tuple(std::get<Ns>(t)...);
+}
+
+/**
+ * @brief      cherry_pick without the copies, a tuple of references to the
+ *             picked elements of t, valid as long as t is
+ *
+ *             auto [id,model] = cherry_pick_view(data,Indexes<0,3>());
+ */
+template<typename... Ts, size_t... Ns>
+std::tuple<const std::tuple_element_t<Ns, std::tuple<Ts...>>&...>
+cherry_pick_view(const std::tuple<Ts...>& t, Indexes<Ns...>)
+{
+    return std::tuple<const std::tuple_element_t<Ns, std::tuple<Ts...>>&...>(std::get<Ns>(t)...);
+}
+
+template<typename... Ts, size_t... Ns>
+std::tuple<std::tuple_element_t<Ns, std::tuple<Ts...>>&...>
+cherry_pick_view(std::tuple<Ts...>& t, Indexes<Ns...>)
+{
+    return std::tuple<std::tuple_element_t<Ns, std::tuple<Ts...>>&...>(std::get<Ns>(t)...);
+}
+
+//a view of a temporary would dangle at the end of the statement
+template<typename... Ts, size_t... Ns>
+void cherry_pick_view(const std::tuple<Ts...>&& t, Indexes<Ns...>) = delete;
+
+#endif // TYPE_LIST_H
@@ -8,173 +8,14 @@
 
 #include "bigHeader.h"
 #include "var_temp.h"
-/*
- Expansion of template parameter pack
-
- @tparam     Stream   { description }
- @tparam     Columns  { description }
-*/
-template<typename Stream, typename... Columns>
-class CSVPrinter{
-	public:	
-		/*
-		 constaining parameter packs to one type
-		
-		 @param[in]  s        { parameter_description }
-		 @param[in]  strings  The strings
-		
-		 @tparam     Strings  { description }
-		*/
-		template<typename... Strings>
-		void outputStrings(const std::string& s,const Strings&... strings) const{
-			writeColumn(s,word_delimeter);
-			outputStrings(strings...);
-		}
-
-		/**
-		 * @brief      { function_description }
-		 *
-		 * @param[in]  s     { parameter_description }
-		 */
-		void outputStrings(const std::string& s){
-			writeColumn(s,"\n");
-		}
-
-		/**
-		 * @brief      { function_description }
-		 *
-		 * @param[in]  columns  The columns
-		 */
-		void outputLine(const Columns&... columns) const{
-			writeLine(validateColoumn(columns)...);
-		}
-		/**
-		 * @brief      { function_description }
-		 *
-		 * @param      _stream  The stream
-		 * @param[in]  headers  The headers
-		 *
-		 * @tparam     Headers  { description }
-		 */
-		template<typename... Headers>
-		CSVPrinter(Stream& _stream,const Headers&... headers)
-			:_stream(_stream),headers({std::string(headers)...}){
-		 	static_assert(sizeof...(Headers) == sizeof...(Columns), 
-            "Number of headers must match number of columns");
-		}
-
-		/**
-		 * @brief      { function_description }
-		 */
-		void outputHeaders(){
-			std::for_each(headers.begin(),headers.end()-1,
-					[=](const std::string& header){
-						writeColumn(header,word_delimeter);
-					}
-
-				);
-			writeColumn(headers.back(),"\n");
-		}
-		
-	private:
-		
-		Stream& _stream;
-		std::array<std::string,sizeof...(Columns)> headers;
-		std::string word_delimeter = ",";
-		std::string line_delimeter = "\n";
-
-		/**
-		 * @brief      Writes a line.
-		 *
-		 * @param[in]  value   The value
-		 * @param[in]  values  The values
-		 *
-		 * @tparam     Value   { description }
-		 * @tparam     Values  { description }
-		 */
-		template <typename Value, typename... Values>
-		void writeLine(const Value& value, const Values&... values) const{
-			writeColumn(value,word_delimeter);
-			writeLine(values...);
-		}
-
-		/**
-		 * @brief      Writes a line.
-		 *
-		 * @param[in]  value  The value
-		 *
-		 * @tparam     Value  { description }
-		 */
-		template<typename Value>
-		void writeLine(const Value& value) const{
-			writeColumn(value,line_delimeter);
-		}
-
-		/**
-		 * @brief      Writes a column.
-		 *
-		 * @param[in]  value      The value
-		 * @param[in]  delimeter  The delimeter
-		 *
-		 * @tparam     Value      { description }
-		 */
-		template<typename Value>
-		void writeColumn(const Value& value,const std::string& delimeter) const{
-			_stream << value << delimeter;
-		}
-
-		/**
-		 * @brief      { function_description }
-		 *
-		 * @param[in]  value  The value
-		 *
-		 * @tparam     Value  { description }
-		 *
-		 * @return     { description_of_the_return_value }
-		 */
-		template<typename Value>
-		const Value& validateColoumn(const Value& value) const{
-			return value;
-		}
-
-};
-
-
-/*
-	traversing template parameter pack 
-*/
-
-
-/**
- * @brief      { struct_description }
- *
- * @tparam     Types  { description }
- */
-template<typename... Types> 
-struct TupleSize;
-
-template<typename Head, typename... Tail> // traverse types
-                                          //
-struct TupleSize<Head, Tail...> 
-{
-    static const size_t value = sizeof(Head) + TupleSize<Tail...>::value;
-};
-
-/**
- * @brief      { struct_description }
- */
-template<> struct TupleSize<>   // end recursion
-{ 
-    static const size_t value = 0;
-};
-
-template<typename Head, typename... Tail> 
-const size_t TupleSize<Head, Tail...>::value;
-
-const size_t TupleSize<>::value;
+#include "csv_printer.h"
+#include "type_list.h"
+#include "soa_vector.h"
+#include "heap_counter.h"
+#include "stopwatch.h"
 
 /*
- 	end of traversing parameter packs for size requitements
+	TupleSize, zip, Indexes and cherry_pick live in type_list.h
 */
 
 // example of expanding a template parameter pack into a set of base classes
@@ -186,59 +27,43 @@ class Derived : public Bases...
 {};
 
 /*
- 	Mested variadic templates
+ 	compile time header names for the csv printer
 */
-
-/**
- * @brief      { struct_description }
- *
- * @tparam     Args1  { description }
- */
-template<typename... Args1>
-struct zip{
-	template<typename... Args2>
-	struct with{
-		typedef std::tuple<std::pair<Args1,Args2>...> type;
-	};
-};
-
-/*
- 	template with two  parameter pack
-
- */
-template <size_t... Ns>
-struct Indexes 
-{};
-template<typename... Ts, size_t... Ns>
-auto cherry_pick(const std::tuple<Ts...>& t, Indexes<Ns...>) ->
-    decltype(std::make_tuple(std::get<Ns>(t)...)) 
-{
-    return std::make_tuple(std::get<Ns>(t)...);
-}
+static constexpr char rollNoHeader[] = "RollNo";
+static constexpr char nameHeader[]   = "Name";
+static constexpr char semHeader[]    = "Sem";
+static constexpr char courseHeader[] = "Course";
+static constexpr char placeHeader[]  = "Place";
 
 /**
  * @brief      { function_description }
  */
 void check_var_temp(){
 	std::ofstream csvStream("csv.txt");
+	/*
+	 	typed columns are formatted straight into the row buffer,
+	 	no temporary strings are built per row
+	 */
 	CSVPrinter<decltype(csvStream),
-		std::string,
-		std::string,
-		std::string,
-		std::string,
-		std::string > printer(csvStream,"RollNo","Name","Sem","Course","Place");
+		int,
+		Labeled<int>,
+		Labeled<int>,
+		Labeled<int>,
+		Labeled<int> > printer(csvStream,
+			CSVHeaders<rollNoHeader,nameHeader,semHeader,courseHeader,placeHeader>());
+	printer.enableBuffering();
 	
 	printer.outputHeaders();
 	for(auto i = 0; i < 20; i++){
 		printer.outputLine(
-			std::to_string(i),
-			"Name"+std::to_string(i),
-			"Sem"+std::to_string(i),
-			"Course"+std::to_string(i),
-			"Place"+std::to_string(i)
+			i,
+			label("Name",i),
+			label("Sem",i),
+			label("Course",i),
+			label("Place",i)
 		);
 	}	
-	
+	printer.flush();
 	csvStream.close();
 	std::cout << TupleSize<std::string,int ,double,long>::value;
 
@@ -257,4 +82,93 @@ void check_var_temp(){
 	 */
 	   auto data = std::make_tuple(10, 12012013, "B737", "Boeing 737", 2, 125000000);
        auto cherry_picked = cherry_pick(data,Indexes<0,2,4>()); 
+       //the same pick as references, "B737" is not copied
+       [[maybe_unused]] auto cherry_viewed = cherry_pick_view(data,Indexes<0,2,4>());
+}
+
+namespace{
+
+/*
+ 	a wide flight record, queries only ever look at a few fields
+*/
+using WideRecord = std::tuple<int,long,std::string,std::string,int,double,std::string>;
+
+WideRecord make_record(int i){
+	return WideRecord(i,12012013L + i,"B737-" + std::to_string(i % 900),
+		"Boeing 737 Next Generation, short to medium range narrow body",2,125000000.0 + i,
+		"scheduled maintenance due in " + std::to_string(i % 365) + " days at the home base");
+}
+
+void expect(bool condition,const char* what){
+	if(!condition){
+		throw std::runtime_error(std::string("cherry pick check failed: ") + what);
+	}
+}
+
+}
+
+void check_cherry_pick(){
+	WideRecord record = make_record(7);
+	const WideRecord& constRecord = record;
+
+	const HeapCounters before = heapCounters();
+	auto view = cherry_pick_view(constRecord,Indexes<0,3,6>());
+	const HeapCounters traffic = heapCounters() - before;
+	expect(traffic.allocations == 0,"a view allocated");
+	expect(&std::get<1>(view) == &std::get<3>(record),"view refers to the record");
+	static_assert(std::is_same<decltype(view),std::tuple<const int&,const std::string&,const std::string&>>::value,
+		"const record gives const references");
+
+	auto [id,price] = cherry_pick_view(record,Indexes<0,5>());
+	price = 1.0;
+	expect(std::get<5>(record) == 1.0 && id == 7,"write through a view");
+
+	//a soa_vector projects whole columns, a row projects references
+	soa_vector<int,std::string,double> fleet;
+	for(int i = 0; i < 100; i++){
+		fleet.emplace_back(i,"A" + std::to_string(300 + i),800.0 + i);
+	}
+	const auto& constFleet = fleet;
+	auto [ids,speeds] = cherry_pick_view(constFleet,Indexes<0,2>());
+	expect(ids.size() == 100 && speeds.data() == constFleet.column<2>().data(),"soa projection");
+	expect(std::get<0>(constFleet.project<1>(42)) == "A342","soa row projection");
+	std::cout << "cherry pick check passed" << std::endl;
+}
+
+void bench_cherry_pick(size_t records){
+	std::vector<WideRecord> table;
+	table.reserve(records);
+	for(size_t i = 0; i < records; i++){
+		table.push_back(make_record(static_cast<int>(i)));
+	}
+
+	//query: id, model and maintenance note of every record
+	size_t copiedBytes = 0;
+	HeapCounters before = heapCounters();
+	Stopwatch watch;
+	for(const WideRecord& record : table){
+		const auto picked = cherry_pick(record,Indexes<0,2,6>());
+		copiedBytes += std::get<1>(picked).size() + std::get<2>(picked).size();
+	}
+	const double copySeconds = watch.seconds();
+	const HeapCounters copyTraffic = heapCounters() - before;
+
+	size_t viewedBytes = 0;
+	before = heapCounters();
+	watch.reset();
+	for(const WideRecord& record : table){
+		const auto picked = cherry_pick_view(record,Indexes<0,2,6>());
+		viewedBytes += std::get<1>(picked).size() + std::get<2>(picked).size();
+	}
+	const double viewSeconds = watch.seconds();
+	const HeapCounters viewTraffic = heapCounters() - before;
+	if(copiedBytes != viewedBytes){
+		throw std::runtime_error("cherry pick bench: copy and view disagree");
+	}
+
+	std::cout << records << " records, 3 of 7 fields projected" << std::endl;
+	std::cout << "  cherry_pick     : " << copySeconds * 1e9 / records << " ns per record, "
+		<< copyTraffic.allocations << " allocations" << std::endl;
+	std::cout << "  cherry_pick_view: " << viewSeconds * 1e9 / records << " ns per record, "
+		<< viewTraffic.allocations << " allocations, " << copySeconds / viewSeconds << "x" << std::endl;
 }
\ No newline at end of file
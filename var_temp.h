@@ -3,5 +3,17 @@
 
 void check_var_temp();
 
+/*
+ 	cherry_pick_view over tuples and soa_vector columns refers to the
+ 	picked fields without copying or allocating
+*/
+void check_cherry_pick();
+
+/*
+ 	projecting 3 fields of wide records, copying cherry_pick against
+ 	cherry_pick_view
+*/
+void bench_cherry_pick(size_t records = 1000000);
+
 
 #endif // VAR_TEMP_H